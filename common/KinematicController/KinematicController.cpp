@@ -312,13 +312,11 @@ double distance_needed(const double v_0, const double v_f, const double a_0) {
 }
 
 double KinematicController::fwdDisp(Direction dir, GlobalPose current_pose, GlobalPose start_pose) {
-  switch (dir) {
-    case Direction::N: return start_pose.row - current_pose.row;
-    case Direction::E: return current_pose.col - start_pose.col;
-    case Direction::S: return current_pose.row - start_pose.row;
-    case Direction::W: return start_pose.col - current_pose.col;
-    default: return std::numeric_limits<double>::quiet_NaN();
+  if (!is_valid_dir(dir)) {
+    return std::numeric_limits<double>::quiet_NaN();
   }
+  return dir_row_delta(dir) * (current_pose.row - start_pose.row)
+         + dir_col_delta(dir) * (current_pose.col - start_pose.col);
 }
 
 double KinematicController::dispToNextEdge(Mouse &mouse) {
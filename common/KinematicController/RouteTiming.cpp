@@ -0,0 +1,93 @@
+#include <common/KinematicController/RouteTiming.h>
+#include <common/KinematicController/VelocityProfile.h>
+#include <algorithm>
+#include <cmath>
+
+namespace smartmouse {
+namespace kc {
+
+double straight_seconds(double d, double v_0, double v_f) {
+  if (d <= 0) {
+    return 0;
+  }
+  return VelocityProfileTiming(d, v_0, v_f).t_f;
+}
+
+route_timing_t route_timing(bool arc_turns) {
+  route_timing_t timing;
+  for (unsigned int after_turn = 0; after_turn < 2; after_turn++) {
+    for (unsigned int before_turn = 0; before_turn < 2; before_turn++) {
+      for (unsigned int n = 1; n <= smartmouse::maze::SIZE; n++) {
+        double d = n;
+        double v_0 = 0;
+        double v_f = 0;
+        if (arc_turns) {
+          d -= 0.5 * (after_turn + before_turn);
+          v_0 = after_turn ? kVf : 0;
+          v_f = before_turn ? kVf : 0;
+        }
+        timing.run[after_turn][before_turn][n - 1] = straight_seconds(d, v_0, v_f);
+      }
+    }
+  }
+
+  // turning in place, each wheel drives along a circle as wide as the track
+  const double quarter_track_circle = M_PI / 2 * TRACK_WIDTH_CU / 2;
+  timing.turn_around = straight_seconds(2 * quarter_track_circle, 0, 0);
+  if (arc_turns) {
+    timing.turn = M_PI / 4 / kVf;
+  } else {
+    timing.turn = straight_seconds(quarter_track_circle, 0, 0);
+  }
+  return timing;
+}
+
+namespace {
+
+struct turn_t {
+  bool arc;
+  double cut;
+  double seconds;
+};
+
+}
+
+double diagonal_route_seconds(const diagonal_route_t &route, Direction facing, bool arc_turns) {
+  const unsigned int moves = route.size();
+
+  // turn i is the one before move i, where turn 0 is from facing and the one after the last move is stopping
+  auto turn = [&](unsigned int i) -> turn_t {
+    if (i == moves || (i == 0 && !is_valid_dir(facing))) {
+      return {false, 0, 0};
+    }
+    const unsigned int from = i == 0 ? 2 * static_cast<unsigned int>(facing) : route[i - 1].octant();
+    const unsigned int eighths = (route[i].octant() - from + 8) % 8;
+    const double theta = std::min(eighths, 8 - eighths) * M_PI / 4;
+    if (theta == 0) {
+      return {false, 0, 0};
+    }
+    if (!arc_turns || theta > M_PI / 2) {
+      return {false, 0, straight_seconds(theta * TRACK_WIDTH_CU / 2, 0, 0)};
+    }
+    // like TimedRoutePlanner, turning from facing takes as long as any other turn, but the first move starts stopped
+    if (i == 0) {
+      return {false, 0, theta * 0.5 / std::tan(theta / 2) / kVf};
+    }
+    const double cut = std::min(0.5 * std::tan(theta / 2), std::min(route[i - 1].length(), route[i].length()) / 2);
+    const double radius = cut / std::tan(theta / 2);
+    return {true, cut, theta * radius / kVf};
+  };
+
+  double seconds = 0;
+  turn_t before = turn(0);
+  for (unsigned int i = 0; i < moves; i++) {
+    const turn_t after = turn(i + 1);
+    seconds += before.seconds;
+    seconds += straight_seconds(route[i].length() - before.cut - after.cut, before.arc ? kVf : 0, after.arc ? kVf : 0);
+    before = after;
+  }
+  return seconds;
+}
+
+}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <common/core/DiagonalRoute.h>
+#include <common/core/TimedRoutePlanner.h>
+#include <common/KinematicController/RobotConfig.h>
+
+namespace smartmouse {
+namespace kc {
+
+/** \brief how long a straight of d cells takes with the jerk limited profile Forward drives, or 0 if d isn't positive */
+double straight_seconds(double d, double v_0, double v_f);
+
+/** \brief predicted seconds for the runs and turns of a route, for TimedRoutePlanner.
+ * Turning in place stops in the middle of the cell and turns the wheels a quarter of the way around the track,
+ * with the same profile as a straight. An arc turn is a quarter circle through the middle of the cell at kVf,
+ * the speed Forward crosses cell edges at, and it cuts half a cell off the runs on both sides of it.
+ */
+route_timing_t route_timing(bool arc_turns);
+
+/** \brief predicted seconds for driving a route with diagonals, starting stopped and facing the given direction.
+ * With arc_turns, every turn of 45 or 90 degrees is an arc at kVf with a radius of half a cell, or less if the moves
+ * on either side are too short, and it cuts the moves on both sides short where it meets them.
+ * Otherwise every turn stops and turns in place. For a route without diagonals, this is what
+ * TimedRoutePlanner::time predicts with route_timing(arc_turns).
+ */
+double diagonal_route_seconds(const diagonal_route_t &route, Direction facing, bool arc_turns);
+
+}
+}
@@ -7,20 +7,20 @@ ReturnToStart::ReturnToStart(Mouse *mouse) : CommandGroup("return"), mouse(mouse
 }
 
 void ReturnToStart::initialize() {
-  //plan path from center to origin
-  mouse->maze->flood_fill_from_point(&pathToStart, smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2, 0, 0);
-  index = 0;
+  //flood from the origin once, every step after that just looks downhill
+  mouse->maze->distance_field(0, 0);
 }
 
 bool ReturnToStart::isFinished() {
   bool groupFinished = CommandGroup::isFinished();
 
   if (groupFinished) {
-    bool returned = mouse->getRow() == 0 && mouse->getCol() == 0;
+    //no direction means we're there, or that there's no way there
+    const DistanceField &field = mouse->maze->distance_field(0, 0);
+    Direction d = field.next_direction(mouse->maze->walls, mouse->getRow(), mouse->getCol(), mouse->getDir());
 
-    if (!returned) {
-      motion_primitive_t prim = pathToStart[index++];
-      addSequential(new Turn(prim.d));
+    if (d != Direction::INVALID) {
+      addSequential(new Turn(d));
       addSequential(new Forward());
 #ifdef CONSOLE
       addSequential(new WaitForStart());
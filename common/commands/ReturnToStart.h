@@ -13,8 +13,6 @@ public:
   bool isFinished();
 
 private:
-  route_t pathToStart;
-  int index;
   Mouse *mouse;
 
 };
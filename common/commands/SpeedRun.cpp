@@ -3,23 +3,43 @@
 #include <commands/Turn.h>
 #include <commands/Forward.h>
 
-SpeedRun::SpeedRun(Mouse *mouse) : CommandGroup("speed"), mouse(mouse) {}
+SpeedRun::SpeedRun(Mouse *mouse, const route_timing_t *timing) : CommandGroup("speed"), mouse(mouse), timing(timing),
+                                                                   timed(false) {}
 
 void SpeedRun::initialize() {
-  index = 0;
-  path = &mouse->maze->fastest_route;
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  timed = timing && TimedRoutePlanner::plan(*timing, mouse->maze->walls, &route, nullptr, mouse->getRow(),
+                                            mouse->getCol(), mouse->getDir(), C, C, N, N);
+
+  //otherwise flood to the center once, every step after that just looks downhill
+  if (!timed) {
+    mouse->maze->distance_field(C, C, N, N);
+  }
 }
 
 bool SpeedRun::isFinished() {
   bool groupFinished = CommandGroup::isFinished();
 
   if (groupFinished) {
-    bool returned = mouse->getRow() == smartmouse::maze::SIZE / 2
-                    && mouse->getCol() == smartmouse::maze::SIZE / 2;
+    //no direction means we're there, or that there's no way there
+    Direction d = Direction::INVALID;
+    if (timed) {
+      if (!route.empty()) {
+        d = route.front().d;
+        if (--route.front().n == 0) {
+          route.pop_front();
+        }
+      }
+    } else {
+      const unsigned int C = smartmouse::maze::CENTER_CORNER;
+      const unsigned int N = smartmouse::maze::CENTER_CELLS;
+      const DistanceField &field = mouse->maze->distance_field(C, C, N, N);
+      d = field.next_direction(mouse->maze->walls, mouse->getRow(), mouse->getCol(), mouse->getDir());
+    }
 
-    if (!returned) {
-      motion_primitive_t prim = path->at(index++);
-      addSequential(new Turn(prim.d));
+    if (d != Direction::INVALID) {
+      addSequential(new Turn(d));
       addSequential(new Forward());
 #ifdef CONSOLE
       addSequential(new WaitForStart());
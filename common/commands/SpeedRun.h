@@ -3,10 +3,14 @@
 #include <common/commanduino/CommanDuino.h>
 #include <common/core/Solver.h>
 #include <common/core/Mouse.h>
+#include <common/core/TimedRoutePlanner.h>
 
 class SpeedRun : public CommandGroup {
 public:
-  SpeedRun(Mouse *mouse);
+  /** \param timing when given, the run follows the route that's predicted to be fastest with it,
+   * otherwise it goes downhill in the distance field, which is a route with the fewest cells
+   */
+  SpeedRun(Mouse *mouse, const route_timing_t *timing = nullptr);
 
   void initialize();
 
@@ -14,6 +18,9 @@ public:
 
 private:
   Mouse *mouse;
-  route_t *path;
-  int index;
+  const route_timing_t *timing;
+
+  /** \brief what's left of the timed route, or empty when going by the distance field */
+  route_t route;
+  bool timed;
 };
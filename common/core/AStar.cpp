@@ -0,0 +1,176 @@
+#include "AStar.h"
+
+#include <algorithm>
+
+#include "IndexedHeap.h"
+
+namespace {
+
+/** \brief how far x is from the nearest of first to first + count - 1 */
+inline unsigned int distance_to_range(unsigned int x, unsigned int first, unsigned int count) {
+  if (x < first) {
+    return first - x;
+  } else if (x >= first + count) {
+    return x - (first + count - 1);
+  }
+  return 0;
+}
+
+}
+
+AStar::AStar(Mouse *mouse)
+    : Solver(mouse), nodes_expanded(0), total_nodes_expanded(0), timing(nullptr), weight_16(16) {}
+
+void AStar::setup() {
+  mouse->reset();
+  mouse->maze->reset();
+  knowledge.reset();
+  mouse->maze->set_walls(knowledge.pessimistic);
+  goal = Solver::Goal::CENTER;
+}
+
+void AStar::setRouteTiming(const route_timing_t *timing) {
+  this->timing = timing;
+}
+
+void AStar::setHeuristicWeight(double weight) {
+  weight_16 = static_cast<unsigned int>(std::max(weight, 0.0) * 16 + 0.5);
+}
+
+void AStar::setGoal(Solver::Goal goal) {
+  this->goal = goal;
+}
+
+bool AStar::search(const MazeWalls &walls, route_t *path, unsigned int row, unsigned int col, unsigned int goal_row,
+                   unsigned int goal_col, unsigned int goal_rows, unsigned int goal_cols) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  path->clear();
+  nodes_expanded = 0;
+  auto open_key = [this](unsigned int g, unsigned int h) -> uint32_t {
+    return std::min(16 * g + weight_16 * h, 0xFFFFu) << 16 | (0xFFFF - g);
+  };
+
+  // a cell nothing has reached yet is infinitely far from the start
+  std::fill(g, g + CELLS, 0xFFFF);
+  IndexedHeap<uint32_t, CELLS> open(key);
+  const uint16_t start = row * SIZE + col;
+  g[start] = 0;
+  key[start] = open_key(0, distance_to_range(row, goal_row, goal_rows) + distance_to_range(col, goal_col, goal_cols));
+  open.push_or_lower(start);
+
+  while (!open.empty()) {
+    const uint16_t i = open.pop();
+    nodes_expanded++;
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+
+    if (r - goal_row < goal_rows && c - goal_col < goal_cols) {
+      total_nodes_expanded += nodes_expanded;
+      // walk back to the start the way the search came
+      for (uint16_t j = i; j != start; j -= smartmouse::maze::index_delta(from[j])) {
+        insert_motion_primitive_front(path, {1, from[j]});
+      }
+      return true;
+    }
+
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
+      const uint16_t next = i + smartmouse::maze::index_delta(d);
+      const uint16_t next_g = g[i] + 1;
+      if (next_g >= g[next]) {
+        continue;
+      }
+      const unsigned int h = distance_to_range(next / SIZE, goal_row, goal_rows) +
+                             distance_to_range(next % SIZE, goal_col, goal_cols);
+      g[next] = next_g;
+      from[next] = d;
+      key[next] = open_key(next_g, h);
+      open.push_or_lower(next);
+    }
+  }
+
+  total_nodes_expanded += nodes_expanded;
+  return false;
+}
+
+motion_primitive_t AStar::planNextStep() {
+  AbstractMaze *maze = mouse->maze;
+  maze->mark_position_visited(mouse->getRow(), mouse->getCol());
+
+  SensorReading sr = mouse->checkWalls();
+  knowledge.update(sr);
+  maze->set_walls(knowledge.pessimistic);
+
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  unsigned int goal_row = C;
+  unsigned int goal_col = C;
+  unsigned int goal_size = N;
+  if (goal == Solver::Goal::START) {
+    goal_row = 0;
+    goal_col = 0;
+    goal_size = 1;
+  }
+
+  // only the route to the goal assuming unknown walls are open is planned every step.
+  // Unlike Flood, the routes from the start to the center wait for teardown
+  solvable = search(knowledge.optimistic, &no_wall_path, mouse->getRow(), mouse->getCol(), goal_row, goal_col,
+                    goal_size, goal_size);
+  maze->path_to_next_goal = no_wall_path;
+
+  if (!solvable || no_wall_path.empty()) {
+    return {0, Direction::INVALID};
+  }
+
+  // go as far along the route as we know is open
+  route_t nextPath = maze->truncate(mouse->getRow(), mouse->getCol(), mouse->getDir(), no_wall_path);
+  return nextPath[0];
+}
+
+route_t AStar::solve() {
+  while (!isFinished()) {
+    mouse->internalTurnToFace(planNextStep().d);
+    mouse->internalForward();
+  }
+
+  // like Flood, the shortest route from the start to the center through walls we know are open.
+  // The route to run, which can be timed, is planned by teardown
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  route_t route;
+  search(knowledge.pessimistic, &route, 0, 0, C, C, N, N);
+  return route;
+}
+
+bool AStar::isFinished() {
+  unsigned int r = mouse->getRow();
+  unsigned int c = mouse->getCol();
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  if (goal == Solver::Goal::CENTER) {
+    return !solvable || (r - C < N && c - C < N);
+  } else if (goal == Solver::Goal::START) {
+    return !solvable || (r == 0 && c == 0);
+  } else {
+    return false;
+  }
+}
+
+void AStar::teardown() {
+  if (goal == Solver::Goal::CENTER) {
+    const unsigned int C = smartmouse::maze::CENTER_CORNER;
+    const unsigned int N = smartmouse::maze::CENTER_CELLS;
+    search(knowledge.optimistic, &mouse->maze->fastest_theoretical_route, 0, 0, C, C, N, N);
+
+    // only known walls are open, so either route is safe to run
+    route_t timed_route;
+    if (timing && TimedRoutePlanner::plan(*timing, knowledge.pessimistic, &timed_route, nullptr, 0, 0, Direction::E,
+                                          C, C, N, N)) {
+      mouse->maze->fastest_route = timed_route;
+    } else {
+      search(knowledge.pessimistic, &mouse->maze->fastest_route, 0, 0, C, C, N, N);
+    }
+  }
+}
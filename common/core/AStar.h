@@ -0,0 +1,79 @@
+/** \brief explores from 0,0 like Flood, but plans each step with A* instead of keeping a distance field.
+ * Flood keeps the distance from every cell to the goal, and repairs it every time it learns a wall.
+ * A* only searches outward from the mouse, toward the goal, in the order of how far the goal would be
+ * with no walls in the way. While most of the maze is unknown it only looks at cells near the straight line
+ * to the goal, so each step looks at far fewer cells than flooding does.
+ * The search state of every cell lives in fixed arrays in the solver, so planning never touches the heap.
+ */
+#pragma once
+
+#include "Solver.h"
+#include "Mouse.h"
+#include "MazeKnowledge.h"
+#include "TimedRoutePlanner.h"
+
+class AStar : public Solver {
+
+public:
+
+  AStar(Mouse *mouse);
+
+  virtual void setup() override;
+
+  virtual motion_primitive_t planNextStep() override;
+
+  virtual route_t solve() override;
+
+  virtual void teardown() override;
+
+  virtual bool isFinished() override;
+
+  virtual void setGoal(Solver::Goal goal) override;
+
+  /** \brief see Flood::setRouteTiming */
+  void setRouteTiming(const route_timing_t *timing);
+
+  /** \brief multiply the heuristic by weight, which is 1 unless it's set.
+   * Over 1, the search heads for the goal more greedily and looks at fewer cells, but the routes it finds
+   * can be up to weight times longer than the shortest ones.
+   */
+  void setHeuristicWeight(double weight);
+
+  /** \brief a shortest route from row, col to the nearest cell of the goal, found with A*.
+   * The heuristic is the Manhattan distance to the goal rectangle, which never overestimates in a grid,
+   * and ties go to the cell farthest from the start, so a search with a clear line to the goal goes straight there.
+   * With a heuristic weight over 1, the route can be longer, see setHeuristicWeight.
+   * \param goal_row, goal_col the top left cell of the goal
+   * \return false and an empty path if the goal can't be reached
+   */
+  bool search(const MazeWalls &walls, route_t *path, unsigned int row, unsigned int col, unsigned int goal_row,
+              unsigned int goal_col, unsigned int goal_rows = 1, unsigned int goal_cols = 1);
+
+  /** \brief cells taken off the open list by the last search */
+  unsigned int nodes_expanded;
+
+  /** \brief cells taken off the open list by every search since the solver was made, to compare with Flood */
+  unsigned long total_nodes_expanded;
+
+private:
+  static constexpr unsigned int CELLS = smartmouse::maze::SIZE * smartmouse::maze::SIZE;
+
+  /// \brief every wall is unknown, open, or a wall. Steps are planned in the optimistic reading
+  MazeKnowledge knowledge;
+
+  route_t no_wall_path;
+  Solver::Goal goal;
+  const route_timing_t *timing;
+
+  /// \brief the heuristic times 16, so the keys can stay integers
+  unsigned int weight_16;
+
+  /// \brief the cost to get to a cell from where the search started
+  uint16_t g[CELLS];
+
+  /// \brief the order of the open list, which is 16 times g plus the weighted heuristic, then the complement of g
+  uint32_t key[CELLS];
+
+  /// \brief which way the search came into each cell, for walking the route back
+  Direction from[CELLS];
+};
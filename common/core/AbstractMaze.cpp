@@ -2,53 +2,41 @@
   @author Peter Mitrano
   */
 #include "AbstractMaze.h"
+#include "WavefrontFlood.h"
 
 #include <string.h>
 #include <string>
 #include <algorithm>
 #include <random>
 #include <string>
-#include <sstream>
+#include <vector>
 
 #ifdef EMBED
 #include <Arduino.h>
 #endif
 
-AbstractMaze::AbstractMaze() : solved(false) {
-  unsigned int i, j;
-  for (i = 0; i < smartmouse::maze::SIZE; i++) {
-    for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      nodes[i][j] = new Node(i, j);
-    }
-  }
+#ifndef ARDUINO
+#include <iterator>
+
+#include "MazeParser.h"
+#endif
+
+AbstractMaze::AbstractMaze() : solved(false), flood_mode(FloodMode::BREADTH_FIRST), route_cache(nullptr) {
+  // nodes start with every wall, just like walls
+  reset();
+  hash = walls.zobrist_hash();
 }
 
 #ifndef ARDUINO
 AbstractMaze::AbstractMaze(std::ifstream &fs) : AbstractMaze() {
-  std::string line;
+  const std::string contents((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  MazeParser parser(contents.data(), contents.size());
 
-  //look West and North to connect any nodes
-  for (unsigned int i = 0; i < smartmouse::maze::SIZE; i++) { //read in each line
-    std::getline(fs, line);
-
-    if (!fs.good()) {
-      print("getline failed");
-      return;
-    }
-
-    unsigned int charPos = 0;
-    for (unsigned int j = 0; j < smartmouse::maze::SIZE; j++) {
-      if (line.at(charPos) != '|') {
-        connect_neighbor(i, j, Direction::W);
-      }
-      charPos++;
-      if (line.at(charPos) != '_') {
-        connect_neighbor(i, j, Direction::S);
-      }
-      charPos++;
-    }
+  MazeWalls maze_walls;
+  if (!parser.next(&maze_walls)) {
+    throw MazeParseError("", 1, 1, "there's no maze here");
   }
-  printf("\n");
+  set_walls(maze_walls);
 }
 #endif
 
@@ -57,39 +45,21 @@ int AbstractMaze::get_node(Node **out, unsigned int row, unsigned int col) {
     return Node::OUT_OF_BOUNDS;
   }
 
-  if (nodes[row][col] == nullptr) {
-    return -1;
-  }
-  (*out) = nodes[row][col];
+  (*out) = &node(row, col);
   return 0;
 }
 
 int AbstractMaze::get_node_in_direction(Node **out, unsigned int row, unsigned int col, const Direction dir) {
-  switch (dir) {
-    case Direction::N:
-      return get_node(out, row - 1, col);
-      break;
-    case Direction::E:
-      return get_node(out, row, col + 1);
-      break;
-    case Direction::S:
-      return get_node(out, row + 1, col);
-      break;
-    case Direction::W:
-      return get_node(out, row, col - 1);
-      break;
-    default:
-      return -1;
+  if (!is_valid_dir(dir)) {
+    return -1;
   }
+  return get_node(out, row + dir_row_delta(dir), col + dir_col_delta(dir));
 }
 
 void AbstractMaze::reset() {
-  unsigned int i, j;
-  for (i = 0; i < smartmouse::maze::SIZE; i++) {
-    for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      nodes[i][j]->weight = -1;
-      nodes[i][j]->known = false;
-    }
+  for (Node &n : nodes) {
+    n.weight = -1;
+    n.known = false;
   }
 }
 
@@ -109,20 +79,21 @@ void AbstractMaze::update(SensorReading sr) {
 }
 
 bool AbstractMaze::flood_fill_from_point(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1) {
-  return flood_fill(path, r0, c0, r1, c1);
+  return incremental_flood_fill(path, r0, c0, r1, c1);
 }
 
 bool AbstractMaze::flood_fill_from_origin(route_t *path, unsigned int r1, unsigned int c1) {
-  return flood_fill(path, 0, 0, r1, c1);
+  return incremental_flood_fill(path, 0, 0, r1, c1);
 }
 
 bool AbstractMaze::flood_fill_from_origin_to_center(route_t *path) {
-  return flood_fill(path, 0, 0, smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2);
+  return incremental_flood_fill(path, 0, 0, smartmouse::maze::CENTER_CORNER, smartmouse::maze::CENTER_CORNER,
+                                smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
 }
 
 bool AbstractMaze::flood_fill(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1) {
   Node *n;
-  Node *goal = nodes[r1][c1];
+  Node *goal = &node(r1, c1);
 
   //incase the maze has already been solved,  reset all weight and known values
   reset();
@@ -131,20 +102,26 @@ bool AbstractMaze::flood_fill(route_t *path, unsigned int r0, unsigned int c0, u
     return true;
   }
 
-  //explore all neighbors of the current node starting  with a weight of 1
-  //return 1 means path to goal was found
-  bool success = false;
   bool solvable = true;
 
+  //explore all neighbors of the start node, giving each the distance from the start as its weight
+  //if the goal can't be reached, walking back from it finds a deadend straight away
+  switch (flood_mode) {
+    case FloodMode::WAVEFRONT:
+      wavefront_assign_weights(this, r0, c0, r1, c1);
+      break;
+    case FloodMode::BREADTH_FIRST:
+    default:
+      assign_weights(r0, c0, r1, c1);
+      break;
+  }
+  path->clear();
+
   //start at the goal
   n = goal;
 
-  //recursively visits all neighbors
-  nodes[r0][c0]->assign_weights_to_neighbors(n, 0, &success);
-  path->clear();
-
   //if we solved the maze,  traverse from goal back to root and record what direction is shortest
-  while (n != nodes[r0][c0] && solvable) {
+  while (n != &node(r0, c0) && solvable) {
     Node *min_node = n;
     Direction min_dir = Direction::N;
 
@@ -152,9 +129,11 @@ bool AbstractMaze::flood_fill(route_t *path, unsigned int r0, unsigned int c0, u
     Direction d;
     bool deadend = true;
     for (d = Direction::First; d < Direction::Last; d++) {
-      if (n->neighbor(d) != nullptr) {
-        if (n->neighbor(d)->weight < min_node->weight) {
-          min_node = n->neighbor(d);
+      Node *neighbor = n->neighbor(d);
+      //nodes beyond the goal may not have been reached by the flood, so they have no weight
+      if (neighbor != nullptr && neighbor->known) {
+        if (neighbor->weight < min_node->weight) {
+          min_node = neighbor;
           min_dir = opposite_direction(d);
           deadend = false;
         }
@@ -173,32 +152,72 @@ bool AbstractMaze::flood_fill(route_t *path, unsigned int r0, unsigned int c0, u
   return solvable;
 }
 
-void AbstractMaze::disconnect_neighbor(unsigned int row, unsigned int col, const Direction dir) {
-  Node *n1 = nullptr;
-  int n1_status = get_node(&n1, row, col);
-  Node *n2 = nullptr;
-  int n2_status = get_node_in_direction(&n2, row, col, dir);
+bool AbstractMaze::assign_weights(unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  RingBuffer<uint16_t, round_up_to_power_of_two(SIZE * SIZE)> frontier;
+
+  Node *start = &node(r0, c0);
+  start->known = true;
+  start->weight = 0;
+  if (r0 == r1 && c0 == c1) {
+    return true;
+  }
+
+  const uint16_t goal = r1 * SIZE + c1;
+  frontier.push_back(r0 * SIZE + c0);
+
+  while (!frontier.empty()) {
+    const uint16_t i = frontier.pop_front();
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+    const int weight = nodes[i].weight + 1;
+
+    //each node is only ever queued once, the first time it's reached is along the shortest path
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
 
-  if (n1_status != Node::OUT_OF_BOUNDS) {
-    n1->neighbors[static_cast<int>(dir)] = nullptr;
+      const uint16_t j = i + smartmouse::maze::index_delta(d);
+
+      Node *neighbor = &nodes[j];
+      if (!neighbor->known) {
+        neighbor->known = true;
+        neighbor->weight = weight;
+
+        //everything closer than the goal already has its final weight, so we can stop here
+        if (j == goal) {
+          return true;
+        }
+
+        frontier.push_back(j);
+      }
+    }
   }
 
-  if (n2_status != Node::OUT_OF_BOUNDS) {
-    n2->neighbors[static_cast<int>(opposite_direction(dir))] = nullptr;
+  return false;
+}
+
+void AbstractMaze::disconnect_neighbor(unsigned int row, unsigned int col, const Direction dir) {
+  // a wall between the perimeter and the outside is always there, so only in bounds walls matter
+  if (row < smartmouse::maze::SIZE && col < smartmouse::maze::SIZE && !walls.is_wall(row, col, dir)) {
+    walls.add_wall(row, col, dir);
+    hash ^= MazeWalls::zobrist_key(row, col, dir);
+    sync_node_walls(row, col, dir);
+    distance_fields.wall_added(walls, row, col, dir);
   }
 }
 
 void AbstractMaze::connect_neighbor(unsigned int row, unsigned int col, const Direction dir) {
-  Node *n1 = nullptr;
-  int n1_status = get_node(&n1, row, col);
-  Node *n2 = nullptr;
-  int n2_status = get_node_in_direction(&n2, row, col, dir);
-
-  Direction opposite = opposite_direction(dir);
-
-  if ((n1_status != Node::OUT_OF_BOUNDS) && (n2_status != Node::OUT_OF_BOUNDS)) {
-    n1->neighbors[static_cast<int>(dir)] = n2;
-    n2->neighbors[static_cast<int>(opposite)] = n1;
+  if (row < smartmouse::maze::SIZE && col < smartmouse::maze::SIZE && walls.is_wall(row, col, dir)) {
+    walls.remove_wall(row, col, dir);
+
+    // remove_wall refuses to knock down the perimeter
+    if (!walls.is_wall(row, col, dir)) {
+      hash ^= MazeWalls::zobrist_key(row, col, dir);
+      sync_node_walls(row, col, dir);
+      distance_fields.wall_removed(walls, row, col, dir);
+    }
   }
 }
 
@@ -209,20 +228,83 @@ void AbstractMaze::connect_all_neighbors(unsigned int row, unsigned int col) {
 }
 
 void AbstractMaze::connect_all_neighbors_in_maze() {
-  unsigned int i, j;
-  for (i = 0; i < smartmouse::maze::SIZE; i++) {
-    for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      connect_all_neighbors(i, j);
+  walls.remove_all_walls();
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+      Node &n = node(r, c);
+      n.walls = 0;
+      for (Direction d = Direction::First; d < Direction::Last; d++) {
+        n.walls |= walls.is_wall(r, c, d) << static_cast<int>(d);
+      }
+    }
+  }
+  hash = walls.zobrist_hash();
+  distance_fields.invalidate();
+}
+
+void AbstractMaze::sync_node_walls(unsigned int row, unsigned int col, const Direction dir) {
+  const bool wall = walls.is_wall(row, col, dir);
+  Node &n = node(row, col);
+  n.walls = (n.walls & ~(1u << static_cast<int>(dir))) | (wall << static_cast<int>(dir));
+
+  // the perimeter never changes, so there's always a node on the other side
+  Node *other = &n + smartmouse::maze::index_delta(dir);
+  const int opposite = static_cast<int>(opposite_direction(dir));
+  other->walls = (other->walls & ~(1u << opposite)) | (wall << opposite);
+}
+
+DistanceField &AbstractMaze::distance_field(unsigned int goal_row, unsigned int goal_col, unsigned int goal_rows,
+                                            unsigned int goal_cols) {
+  return distance_fields.get(walls, goal_row, goal_col, goal_rows, goal_cols);
+}
+
+void AbstractMaze::set_walls(const MazeWalls &new_walls) {
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    unsigned int changed = walls.horizontal[r] ^ new_walls.horizontal[r];
+    while (changed) {
+      unsigned int c = __builtin_ctz(changed);
+      if ((new_walls.horizontal[r] >> c) & 1u) {
+        disconnect_neighbor(r, c, Direction::S);
+      } else {
+        connect_neighbor(r, c, Direction::S);
+      }
+      changed &= changed - 1;
+    }
+
+    changed = walls.vertical[r] ^ new_walls.vertical[r];
+    while (changed) {
+      unsigned int c = __builtin_ctz(changed);
+      if ((new_walls.vertical[r] >> c) & 1u) {
+        disconnect_neighbor(r, c, Direction::E);
+      } else {
+        connect_neighbor(r, c, Direction::E);
+      }
+      changed &= changed - 1;
     }
   }
 }
 
+bool AbstractMaze::incremental_flood_fill(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1,
+                                          unsigned int c1, unsigned int goal_rows, unsigned int goal_cols) {
+  bool solvable;
+  if (route_cache != nullptr
+      && route_cache->lookup(hash, r0, c0, r1, c1, goal_rows, goal_cols, path, &solvable)) {
+    return solvable;
+  }
+
+  solvable = distance_field(r1, c1, goal_rows, goal_cols).route(walls, path, r0, c0);
+  if (route_cache != nullptr) {
+    route_cache->store(hash, r0, c0, r1, c1, goal_rows, goal_cols, *path, solvable);
+  }
+  return solvable;
+}
+
 void AbstractMaze::mark_position_visited(unsigned int row, unsigned int col) {
-  nodes[row][col]->visited = true;
+  node(row, col).visited = true;
 }
 
 void AbstractMaze::mark_origin_known() {
-  nodes[0][0]->known = true;
+  node(0, 0).known = true;
 }
 
 void AbstractMaze::print_maze_str(char *buff) {
@@ -230,27 +312,25 @@ void AbstractMaze::print_maze_str(char *buff) {
   unsigned int i, j;
   for (i = 0; i < smartmouse::maze::SIZE; i++) {
     for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      Node *n = nodes[i][j];
-      if (n->neighbor(Direction::W) == nullptr) {
-        strcpy(b++, "|");
-        if (n->neighbor(Direction::S) == nullptr) {
-          strcpy(b++, "_");
+      if (walls.is_wall(i, j, Direction::W)) {
+        *(b++) = '|';
+        if (walls.is_wall(i, j, Direction::S)) {
+          *(b++) = '_';
         } else {
-          strcpy(b++, " ");
+          *(b++) = ' ';
         }
       } else {
-        strcpy(b++, "_");
-        if (n->neighbor(Direction::S) == nullptr) {
-          strcpy(b++, "_");
+        *(b++) = '_';
+        if (walls.is_wall(i, j, Direction::S)) {
+          *(b++) = '_';
         } else {
-          strcpy(b++, " ");
+          *(b++) = ' ';
         }
       }
     }
     *(b++) = '|';
     *(b++) = '\n';
   }
-  b++;
   *b = '\0';
 }
 
@@ -265,7 +345,7 @@ void AbstractMaze::print_neighbor_maze() {
   for (i = 0; i < smartmouse::maze::SIZE; i++) {
     for (j = 0; j < smartmouse::maze::SIZE; j++) {
       for (Direction d = Direction::First; d < Direction::Last; d++) {
-        bool wall = (nodes[i][j]->neighbor(d) == nullptr);
+        bool wall = walls.is_wall(i, j, d);
         print("%i", wall);
       }
       print(" ");
@@ -278,208 +358,203 @@ void AbstractMaze::print_weight_maze() {
   unsigned int i, j;
   for (i = 0; i < smartmouse::maze::SIZE; i++) {
     for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      int w = nodes[i][j]->weight;
+      int w = node(i, j).weight;
       print("%03u ", w);
     }
     print("\r\n");
   }
 }
 
-void AbstractMaze::print_dist_maze() {
-  unsigned int i, j;
-  for (i = 0; i < smartmouse::maze::SIZE; i++) {
-    for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      Node *n = nodes[i][j];
-      int d = n->distance;
-      if (d < 10) {
-        print("  %d ", d);
-      } else if (d < 100) {
-        print(" %d ", d);
-      } else {
-        print("%d ", d);
-      }
-    }
-    print("\r\n");
-  }
-}
-
 void AbstractMaze::print_pointer_maze() {
   unsigned int i, j;
   for (i = 0; i < smartmouse::maze::SIZE; i++) {
     for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      print("%p ", nodes[i][j]);
+      print("%p ", &node(i, j));
     }
     print("\r\n");
   }
 }
 
 AbstractMaze AbstractMaze::gen_random_legal_maze() {
+  std::mt19937 rng(std::rand());
   AbstractMaze maze;
+  maze.set_walls(gen_random_legal_walls(rng));
+  return maze;
+}
 
-  // start at center and move out, marking visited nodes as we go
-  maze.mark_position_visited(smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2);
-  maze.mark_position_visited(smartmouse::maze::SIZE / 2 - 1, smartmouse::maze::SIZE / 2);
-  maze.mark_position_visited(smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2 - 1);
-  maze.mark_position_visited(smartmouse::maze::SIZE / 2 - 1, smartmouse::maze::SIZE / 2 - 1);
+AbstractMaze AbstractMaze::gen_random_legal_maze(uint32_t seed, uint32_t index) {
+  AbstractMaze maze;
+  maze.set_walls(gen_random_legal_walls(seed, index));
+  return maze;
+}
 
-  // pick std::random start node of the four possible ones;
-  unsigned int starting_row = smartmouse::maze::SIZE / 2 - std::rand() % 2;
-  unsigned int starting_col = smartmouse::maze::SIZE / 2 - std::rand() % 2;
-  Node *start_node = nullptr;
-  maze.get_node(&start_node, starting_row, starting_col);
-  _make_connections(&maze, start_node);
+MazeWalls AbstractMaze::gen_random_legal_walls(uint32_t seed, uint32_t index) {
+  // splitmix64 of both, so neighbouring indices seed unrelated mazes
+  uint64_t z = (((uint64_t) seed << 32) | index) * 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  std::mt19937 rng(static_cast<uint32_t>(z ^ (z >> 31)));
+  return gen_random_legal_walls(rng);
+}
 
-  // knock down some more randomly
-  unsigned int i = 0;
-  while (i < smartmouse::maze::SIZE * smartmouse::maze::SIZE / 5) {
-    unsigned int row = std::rand() % (smartmouse::maze::SIZE - 2) + 1;
-    unsigned int col = std::rand() % (smartmouse::maze::SIZE - 2) + 1;
-    int d = std::rand() % 4;
-    Direction dir = int_to_dir(d);
+namespace {
 
-    // check if that's a valid wall to knock down
-    bool can_delete = false;
+/** \brief a number less than n from rng. uniform_int_distribution and std::shuffle are different in every standard
+ * library, but the numbers mt19937 makes are fixed by the standard, so this gives the same mazes everywhere.
+ */
+unsigned int random_below(std::mt19937 &rng, unsigned int n) {
+  return rng() % n;
+}
+
+}
+
+MazeWalls AbstractMaze::gen_random_legal_walls(std::mt19937 &rng) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  constexpr unsigned int CORNER = smartmouse::maze::CENTER_CORNER;
+
+  MazeWalls maze_walls;
+  MazeWalls::row_bits_t visited[SIZE] = {};
+  for (unsigned int r = CORNER; r < CORNER + smartmouse::maze::CENTER_CELLS; r++) {
+    for (unsigned int c = CORNER; c < CORNER + smartmouse::maze::CENTER_CELLS; c++) {
+      visited[r] |= 1u << c;
+    }
+  }
+
+  // depth first search out from one of the center cells, knocking down the wall to each cell it hasn't been to.
+  // The stack is explicit so it's a fixed size, where recursion could go SIZE * SIZE calls deep
+  struct frame_t {
+    uint8_t row;
+    uint8_t col;
+    uint8_t next; // index into dirs of the next direction to try
+    Direction dirs[4];
+  };
+  std::array<frame_t, SIZE * SIZE> stack;
+  unsigned int top = 0;
+
+  auto push = [&](unsigned int row, unsigned int col) {
+    frame_t &frame = stack[top++];
+    frame.row = row;
+    frame.col = col;
+    frame.next = 0;
+    frame.dirs[0] = Direction::N;
+    frame.dirs[1] = Direction::E;
+    frame.dirs[2] = Direction::S;
+    frame.dirs[3] = Direction::W;
+    // shuffle them with a single draw, read as the digits of a number in base 4, then 3, then 2
+    uint32_t digits = rng();
+    for (unsigned int i = 3; i > 0; i--) {
+      std::swap(frame.dirs[i], frame.dirs[digits % (i + 1)]);
+      digits /= i + 1;
+    }
+  };
+
+  push(CORNER + random_below(rng, 2), CORNER + random_below(rng, 2));
+  while (top > 0) {
+    frame_t &frame = stack[top - 1];
+    if (frame.next == 4) {
+      top--;
+      continue;
+    }
 
+    const Direction dir = frame.dirs[frame.next++];
+    unsigned int row = frame.row;
+    unsigned int col = frame.col;
     switch (dir) {
-      case Direction::N: {
-        Node *left = nullptr;
-        Node *right = nullptr;
-        Node *above = nullptr;
-        maze.get_node(&left, row, col - 1);
-        maze.get_node(&right, row, col + 1);
-        maze.get_node(&above, row - 1, col);
-        if ((left->wall(Direction::N) || left->wall(Direction::E) || above->wall(Direction::W)) &&
-            (right->wall(Direction::N) || right->wall(Direction::W) || above->wall(Direction::E))) {
-          can_delete = true;
-        }
-      }
+      case Direction::N:
+        if (row == 0) continue;
+        row--;
         break;
-      case Direction::E: {
-        Node *below = nullptr;
-        Node *right = nullptr;
-        Node *above = nullptr;
-        maze.get_node(&below, row + 1, col);
-        maze.get_node(&right, row, col + 1);
-        maze.get_node(&above, row - 1, col);
-        if ((above->wall(Direction::S) || above->wall(Direction::E) || right->wall(Direction::N)) &&
-            (below->wall(Direction::N) || below->wall(Direction::E) || right->wall(Direction::S))) {
-          can_delete = true;
-        }
-      }
+      case Direction::E:
+        if (col == SIZE - 1) continue;
+        col++;
         break;
-      case Direction::S: {
-        Node *left = nullptr;
-        Node *right = nullptr;
-        Node *below = nullptr;
-        maze.get_node(&left, row, col - 1);
-        maze.get_node(&right, row, col + 1);
-        maze.get_node(&below, row + 1, col);
-        if ((left->wall(Direction::S) || left->wall(Direction::E) || below->wall(Direction::W)) &&
-            (right->wall(Direction::S) || right->wall(Direction::W) || below->wall(Direction::E))) {
-          can_delete = true;
-        }
-      }
+      case Direction::S:
+        if (row == SIZE - 1) continue;
+        row++;
         break;
-      case Direction::W: {
-        Node *below = nullptr;
-        Node*left = nullptr;
-        Node *above = nullptr;
-        maze.get_node(&below, row + 1, col);
-        maze.get_node(&left, row, col - 1);
-        maze.get_node(&above, row - 1, col);
-        if ((above->wall(Direction::S) || above->wall(Direction::W) || left->wall(Direction::N)) &&
-            (below->wall(Direction::N) || below->wall(Direction::W) || left->wall(Direction::S))) {
-          can_delete = true;
-        }
-      }
+      case Direction::W:
+        if (col == 0) continue;
+        col--;
         break;
       default:
-          break;
+        continue;
     }
 
-    if (can_delete) {
-      maze.connect_neighbor(row, col, dir);
-      i++;
+    if ((visited[row] >> col) & 1u) {
+      continue;
     }
+    visited[row] |= 1u << col;
+    maze_walls.remove_wall(frame.row, frame.col, dir);
+    push(row, col);
   }
 
-  // knock down center square
-  maze.connect_neighbor(smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2, Direction::N);
-  maze.connect_neighbor(smartmouse::maze::SIZE / 2, smartmouse::maze::SIZE / 2, Direction::W);
-  maze.connect_neighbor(smartmouse::maze::SIZE / 2 - 1, smartmouse::maze::SIZE / 2 - 1, Direction::S);
-  maze.connect_neighbor(smartmouse::maze::SIZE / 2 - 1, smartmouse::maze::SIZE / 2 - 1, Direction::E);
-
-  return maze;
-}
-
-void AbstractMaze::_make_connections(AbstractMaze *maze, Node *node) {
-  static std::random_device rd;
-  static std::mt19937 g(rd());
-
-  unsigned int r = node->row();
-  unsigned int c = node->col();
-  maze->mark_position_visited(r, c);
-
-  // shuffle directions
-  std::vector<Direction> dirs = {Direction::N, Direction::E, Direction::S, Direction::W};
-  std::shuffle(dirs.begin(), dirs.end(), g);
+  // knock down some more randomly, but never one that would leave a post with no walls touching it
+  unsigned int i = 0;
+  while (i < SIZE * SIZE / 5) {
+    unsigned int row = random_below(rng, SIZE - 2) + 1;
+    unsigned int col = random_below(rng, SIZE - 2) + 1;
+    Direction dir = int_to_dir(random_below(rng, 4));
 
-  for (auto d : dirs) {
-    Node *neighbor;
-    int result = maze->get_node_in_direction(&neighbor, r, c, d);
-    if (result != Node::OUT_OF_BOUNDS && result != -1) {
-      if (!neighbor->visited) {
-        maze->connect_neighbor(r, c, d);
-        _make_connections(maze, neighbor);
-      }
+    bool can_delete = false;
+    const MazeWalls &w = maze_walls;
+    switch (dir) {
+      case Direction::N:
+        can_delete = (w.is_wall(row, col - 1, Direction::N) || w.is_wall(row, col - 1, Direction::E)
+                      || w.is_wall(row - 1, col, Direction::W))
+                     && (w.is_wall(row, col + 1, Direction::N) || w.is_wall(row, col + 1, Direction::W)
+                         || w.is_wall(row - 1, col, Direction::E));
+        break;
+      case Direction::E:
+        can_delete = (w.is_wall(row - 1, col, Direction::S) || w.is_wall(row - 1, col, Direction::E)
+                      || w.is_wall(row, col + 1, Direction::N))
+                     && (w.is_wall(row + 1, col, Direction::N) || w.is_wall(row + 1, col, Direction::E)
+                         || w.is_wall(row, col + 1, Direction::S));
+        break;
+      case Direction::S:
+        can_delete = (w.is_wall(row, col - 1, Direction::S) || w.is_wall(row, col - 1, Direction::E)
+                      || w.is_wall(row + 1, col, Direction::W))
+                     && (w.is_wall(row, col + 1, Direction::S) || w.is_wall(row, col + 1, Direction::W)
+                         || w.is_wall(row + 1, col, Direction::E));
+        break;
+      case Direction::W:
+        can_delete = (w.is_wall(row - 1, col, Direction::S) || w.is_wall(row - 1, col, Direction::W)
+                      || w.is_wall(row, col - 1, Direction::N))
+                     && (w.is_wall(row + 1, col, Direction::N) || w.is_wall(row + 1, col, Direction::W)
+                         || w.is_wall(row, col - 1, Direction::S));
+        break;
+      default:
+        break;
     }
-  }
-}
 
-std::string route_to_string(route_t &route) {
-  std::stringstream ss;
-  if (route.empty()) {
-    ss << "empty";
+    if (can_delete) {
+      maze_walls.remove_wall(row, col, dir);
+      i++;
+    }
   }
 
-  for (motion_primitive_t prim : route) {
-    ss << (int)prim.n << dir_to_char(prim.d);
-  }
+  // knock down center square
+  maze_walls.remove_wall(CORNER + 1, CORNER + 1, Direction::N);
+  maze_walls.remove_wall(CORNER + 1, CORNER + 1, Direction::W);
+  maze_walls.remove_wall(CORNER, CORNER, Direction::S);
+  maze_walls.remove_wall(CORNER, CORNER, Direction::E);
 
-  return ss.str();
+  return maze_walls;
 }
 
-void insert_motion_primitive_back(route_t *route, motion_primitive_t prim) {
-  if (!route->empty() && prim.d == route->back().d) {
-    route->back().n += prim.n;
-  }
-  else {
-    route->insert(route->cend(), prim);
-  }
-}
-void insert_motion_primitive_front(route_t *route, motion_primitive_t prim) {
-  if (!route->empty() && prim.d == route->front().d) {
-    route->front().n += prim.n;
-  }
-  else {
-    route->insert(route->cbegin(), prim);
-  }
-}
-
-route_t AbstractMaze::truncate(unsigned int row, unsigned int col, Direction dir, route_t route) {
+route_t AbstractMaze::truncate(unsigned int row, unsigned int col, Direction dir, const route_t &route) {
   route_t trunc;
-  Node *n = nodes[row][col];
   bool done = false;
-  for (motion_primitive_t prim : route) {
+  for (const motion_primitive_t &prim : route) {
     for (unsigned int i = 0; i < prim.n; i++) {
       // check if this move is valid
-      if (n->wall(prim.d)) {
+      if (walls.is_wall(row, col, prim.d)) {
         done = true;
         break;
       }
 
       // if it's valid, add and simulate the move
-      n = n->neighbor(prim.d);
+      row += dir_row_delta(prim.d);
+      col += dir_col_delta(prim.d);
       insert_motion_primitive_back(&trunc, {1, prim.d});
     }
     if (done) {
@@ -490,17 +565,5 @@ route_t AbstractMaze::truncate(unsigned int row, unsigned int col, Direction dir
 }
 
 bool AbstractMaze::operator==(const AbstractMaze &other) const {
-  unsigned int i, j;
-  for (i = 0; i < smartmouse::maze::SIZE; i++) {
-    for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      for (Direction d = Direction::First; d != Direction::Last; d++) {
-        bool n1 = static_cast<bool>(nodes[i][j]->neighbor(d));
-        bool n2 = static_cast<bool>(other.nodes[i][j]->neighbor(d));
-        if (n1 ^ n2) {
-          return false;
-        }
-      }
-    }
-  }
-  return true;
+  return walls == other.walls;
 }
@@ -12,49 +12,25 @@
 #include "SensorReading.h"
 #include "Node.h"
 #include "Direction.h"
-#include <vector>
+#include "RingBuffer.h"
+#include "MazeWalls.h"
+#include "DistanceField.h"
+#include "Route.h"
+#include "RouteCache.h"
+#include <array>
+#include <random>
+#include <stdint.h>
 
 /**
  * \brief the maze is graph of nodes, stored internally as an matrix.
- * don't forget to call free_maze(maze) after a maze is done being used
+ * The walls live in a MazeWalls bitboard, and the nodes only hold search state.
  */
 
-struct motion_primitive_t {
-  uint8_t n;
-  Direction d;
+/** \brief which search flood_fill uses to assign weights, they all give the same routes */
+enum class FloodMode {
+  BREADTH_FIRST, // AbstractMaze::assign_weights
+  WAVEFRONT // wavefront_assign_weights, see WavefrontFlood.h
 };
-typedef std::vector<motion_primitive_t> route_t;
-
-std::string route_to_string(route_t &route);
-void insert_motion_primitive_front(route_t *route, motion_primitive_t prim);
-void insert_motion_primitive_back(route_t *route, motion_primitive_t prim);
-
-namespace smartmouse {
-namespace maze {
-
-constexpr static unsigned int SIZE = 16;
-const unsigned long BUFF_SIZE = (SIZE * 2 + 3) * SIZE;
-constexpr static unsigned int CENTER = SIZE / 2;
-constexpr static double UNIT_DIST_M = 0.18;
-constexpr static double WALL_THICKNESS_M = 0.012;
-constexpr static double HALF_WALL_THICKNESS_M = WALL_THICKNESS_M / 2.0;
-constexpr static double HALF_UNIT_DIST = UNIT_DIST_M / 2.0;
-constexpr static double SIZE_M = SIZE * UNIT_DIST_M;
-
-constexpr double toMeters(double cu) {
-  return cu * UNIT_DIST_M;
-}
-
-constexpr double toCellUnits(double meters) {
-  return meters / UNIT_DIST_M;
-}
-
-constexpr double WALL_THICKNESS_CU = toCellUnits(WALL_THICKNESS_M);
-constexpr double HALF_WALL_THICKNESS_CU = toCellUnits(HALF_WALL_THICKNESS_M);
-constexpr double SIZE_CU = toCellUnits(SIZE_M);
-
-}
-}
 
 class AbstractMaze {
   friend class Mouse;
@@ -65,13 +41,37 @@ class AbstractMaze {
   route_t fastest_route;
   route_t fastest_theoretical_route;
   route_t path_to_next_goal;
+  FloodMode flood_mode;
+
+  /** \brief Zobrist hash of walls, kept up to date by connect_neighbor and disconnect_neighbor */
+  uint64_t hash;
+
+  /** \brief when set, incremental_flood_fill reuses routes it already planned in the same walls.
+   * The cache isn't owned by the maze, and copies of the maze share it.
+   */
+  RouteCache *route_cache;
 
-  /** \brief allocates and initializes a node
-   * allocates a maze of the given size and sets all links in graph to be null. Naturally, it's column major.
+  /** \brief initializes the nodes of a maze with every wall present.
+   * Naturally, it's column major.
    */
   AbstractMaze();
 
+  /** \brief nodes don't point back at their maze, so copying or moving a maze is just copying its bytes.
+   * For a 16x16 maze that's about 8 KB: the three routes are 2 KB each, and the nodes and distance fields 1 KB each.
+   * Copy a MazeWalls instead when only the walls are needed, which is 64 bytes.
+   */
+  AbstractMaze(const AbstractMaze &other) = default;
+
+  AbstractMaze(AbstractMaze &&other) = default;
+
+  AbstractMaze &operator=(const AbstractMaze &other) = default;
+
+  AbstractMaze &operator=(AbstractMaze &&other) = default;
+
 #ifndef ARDUINO // this can't exist on arduino
+  /** \brief read the first maze in the rest of the stream, see MazeParser for the format
+   * \throws MazeParseError if there's no maze, or it isn't valid
+   */
   AbstractMaze(std::ifstream &fs);
 #endif
 
@@ -79,7 +79,8 @@ class AbstractMaze {
 
   void mark_position_visited(unsigned int row, unsigned int col);
 
-  /** \brief add the neighbor in the given direction
+  /** \brief add the neighbor in the given direction.
+   * Change walls through here or disconnect_neighbor so that the distance fields get repaired.
    * \param dir direction connect in
    */
   void connect_neighbor(unsigned int row, unsigned int col, const Direction dir);
@@ -95,14 +96,36 @@ class AbstractMaze {
    */
   void update(SensorReading sr);
 
-  //This method will take a maze and perform a traditional flood fill
-  //the fill starts from r0, c0 and ends at r1, c1
+  //These find the route from r0, c0 to r1, c1 with incremental_flood_fill,
+  //so asking for many routes to the same goal only floods once
   bool flood_fill_from_point(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1);
 
   bool flood_fill_from_origin(route_t *path, unsigned int r1, unsigned int c1);
 
+  /** \brief route to whichever of the four center cells is nearest */
   bool flood_fill_from_origin_to_center(route_t *path);
 
+  /** \brief finds the same length route as flood_fill, but by walking downhill in the distance field of r1, c1.
+   * The field is only flooded from scratch the first time a goal is used,
+   * after that it's repaired as walls are connected and disconnected.
+   * Ties between equally short routes may be broken differently than flood_fill breaks them.
+   * Node weights aren't touched.
+   * \param goal_rows, goal_cols the size of the goal, when it's more than the cell r1, c1. The route ends at the nearest
+   * goal cell.
+   */
+  bool incremental_flood_fill(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+                              unsigned int goal_rows = 1, unsigned int goal_cols = 1);
+
+  /** \brief get the distance field for a goal, computing it if we don't have one for that goal yet.
+   * Only the last DistanceFieldCache::SLOTS goals are remembered.
+   * \param goal_row, goal_col the top left cell of the goal
+   */
+  DistanceField &distance_field(unsigned int goal_row, unsigned int goal_col, unsigned int goal_rows = 1,
+                                unsigned int goal_cols = 1);
+
+  /** \brief replace all the walls, repairing the distance fields one changed wall at a time */
+  void set_walls(const MazeWalls &new_walls);
+
   /** \brief connect all neighbors in the whole maze
    * \param i row
    * \param j col
@@ -135,7 +158,7 @@ class AbstractMaze {
   /** \brief walks along a route in the maze and return the longest valid path
    * Valid means you don't walk through any walls.
    */
-  route_t truncate(unsigned int row, unsigned int col, Direction dir, route_t route);
+  route_t truncate(unsigned int row, unsigned int col, Direction dir, const route_t &route);
 
   /** prints a maze
   * @param maze the maze
@@ -157,17 +180,56 @@ class AbstractMaze {
 
   /** duh*/
   void print_weight_maze();
-
-  /** duh*/
-  void print_dist_maze();
 #pragma clang diagnostic pop
 
+  /** \brief a random maze with a route to the center, seeded from std::rand() so srand repeats it */
   static AbstractMaze gen_random_legal_maze();
-  static void _make_connections(AbstractMaze *maze, Node *node);
 
+  /** \brief the index'th maze made from seed, see gen_random_legal_walls */
+  static AbstractMaze gen_random_legal_maze(uint32_t seed, uint32_t index = 0);
+
+  /** \brief the same seed and index give the same walls on any platform, and no maze depends on any other,
+   * so a batch of them can be split between threads any way you like.
+   */
+  static MazeWalls gen_random_legal_walls(uint32_t seed, uint32_t index = 0);
+
+  /** \brief the walls of a random maze drawn only from rng, without making any nodes, so it's cheap enough to make
+   * a corpus of millions and each thread can use its own rng
+   */
+  static MazeWalls gen_random_legal_walls(std::mt19937 &rng);
+
+  /** \brief the traditional flood fill, which searches from r0, c0 with flood_mode every time it's called.
+   * Leaves the weight of each node it reached set to its distance from r0, c0.
+   */
   bool flood_fill(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1);
 
+  /** \brief breadth first search that sets the weight of each node to its distance from r0, c0.
+   * Each node is visited at most once, using a fixed size queue instead of recursion or the heap.
+   * The search stops as soon as r1, c1 is reached, so nodes farther away than the goal may be left unknown.
+   * Call reset() first.
+   * \return true if the goal was reached
+   */
+  bool assign_weights(unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1);
+
+  /** \brief compares only the walls of the two mazes */
   bool operator==(const AbstractMaze &other) const;
 
-  Node *nodes[smartmouse::maze::SIZE][smartmouse::maze::SIZE]; // array of node pointers
+  MazeWalls walls;
+
+  /** \brief row after row, use node(row, col) to look one up */
+  std::array<Node, smartmouse::maze::SIZE * smartmouse::maze::SIZE> nodes;
+
+  inline Node &node(unsigned int row, unsigned int col) {
+    return nodes[row * smartmouse::maze::SIZE + col];
+  }
+
+  inline const Node &node(unsigned int row, unsigned int col) const {
+    return nodes[row * smartmouse::maze::SIZE + col];
+  }
+
+  DistanceFieldCache distance_fields;
+
+ private:
+  /** \brief copy one wall from walls into the nodes on both sides of it */
+  void sync_node_walls(unsigned int row, unsigned int col, const Direction dir);
 };
@@ -0,0 +1,255 @@
+#include "DStarLite.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+/** \brief the Manhattan distance between two cells, which never overestimates in a grid */
+inline unsigned int heuristic(uint16_t a, uint16_t b) {
+  const int rows = static_cast<int>(a / SIZE) - static_cast<int>(b / SIZE);
+  const int cols = static_cast<int>(a % SIZE) - static_cast<int>(b % SIZE);
+  return std::abs(rows) + std::abs(cols);
+}
+
+}
+
+constexpr uint16_t DStarLite::INFINITE;
+
+DStarLite::DStarLite(Mouse *mouse)
+    : Solver(mouse), nodes_expanded(0), total_nodes_expanded(0), timing(nullptr), searching(false), goal_row(0),
+      goal_col(0), goal_size(0), start(0), last(0), km(0), open(&key[0]) {}
+
+void DStarLite::setup() {
+  mouse->reset();
+  mouse->maze->reset();
+  knowledge.reset();
+  mouse->maze->set_walls(knowledge.pessimistic);
+  goal = Solver::Goal::CENTER;
+  searching = false;
+}
+
+void DStarLite::setRouteTiming(const route_timing_t *timing) {
+  this->timing = timing;
+}
+
+void DStarLite::setGoal(Solver::Goal goal) {
+  this->goal = goal;
+}
+
+void DStarLite::initialize(unsigned int goal_row, unsigned int goal_col, unsigned int goal_size) {
+  this->goal_row = goal_row;
+  this->goal_col = goal_col;
+  this->goal_size = goal_size;
+  searching = true;
+  km = 0;
+  last = start;
+  std::fill(g, g + CELLS, INFINITE);
+  std::fill(rhs, rhs + CELLS, INFINITE);
+  open.clear();
+  for (unsigned int r = goal_row; r < goal_row + goal_size; r++) {
+    for (unsigned int c = goal_col; c < goal_col + goal_size; c++) {
+      const uint16_t s = r * SIZE + c;
+      rhs[s] = 0;
+      key[s] = calculate_key(s);
+      open.push_or_lower(s);
+    }
+  }
+}
+
+uint32_t DStarLite::calculate_key(uint16_t s) const {
+  const uint32_t k2 = std::min(g[s], rhs[s]);
+  if (k2 == INFINITE) {
+    return 0xFFFFFFFF;
+  }
+  return (k2 + heuristic(start, s) + km) << 16 | k2;
+}
+
+void DStarLite::update_vertex(uint16_t s) {
+  if (!is_goal(s)) {
+    rhs[s] = INFINITE;
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (!knowledge.optimistic.is_wall(s / SIZE, s % SIZE, d)) {
+        const uint16_t next_g = g[s + smartmouse::maze::index_delta(d)];
+        if (next_g != INFINITE) {
+          rhs[s] = std::min<uint16_t>(rhs[s], next_g + 1);
+        }
+      }
+    }
+  }
+
+  if (g[s] != rhs[s]) {
+    key[s] = calculate_key(s);
+    if (open.queued(s)) {
+      open.update(s);
+    } else {
+      open.push_or_lower(s);
+    }
+  } else if (open.queued(s)) {
+    open.remove(s);
+  }
+}
+
+void DStarLite::compute_shortest_path() {
+  while (!open.empty() && (key[open.top()] < calculate_key(start) || rhs[start] != g[start])) {
+    const uint16_t u = open.top();
+    const uint32_t k_new = calculate_key(u);
+    nodes_expanded++;
+
+    // the mouse has moved closer since u was queued, so it goes back in with its key as of now
+    if (key[u] < k_new) {
+      key[u] = k_new;
+      open.update(u);
+      continue;
+    }
+
+    if (g[u] > rhs[u]) {
+      g[u] = rhs[u];
+      open.remove(u);
+    } else {
+      g[u] = INFINITE;
+      update_vertex(u);
+    }
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (!knowledge.optimistic.is_wall(u / SIZE, u % SIZE, d)) {
+        update_vertex(u + smartmouse::maze::index_delta(d));
+      }
+    }
+  }
+}
+
+motion_primitive_t DStarLite::planNextStep() {
+  AbstractMaze *maze = mouse->maze;
+  maze->mark_position_visited(mouse->getRow(), mouse->getCol());
+  nodes_expanded = 0;
+
+  // the search is over the optimistic reading, which changes when a wall we hadn't seen turns out to be there,
+  // and also when a reading disagrees with an earlier noisy one and opens a wall back up
+  SensorReading sr = mouse->checkWalls();
+  bool was_wall[4] = {};
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    was_wall[static_cast<int>(d)] = knowledge.optimistic.is_wall(sr.row, sr.col, d);
+  }
+  knowledge.update(sr);
+  maze->set_walls(knowledge.pessimistic);
+
+  Direction changed_walls[4];
+  unsigned int changed_wall_count = 0;
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    if (knowledge.optimistic.is_wall(sr.row, sr.col, d) != was_wall[static_cast<int>(d)]) {
+      changed_walls[changed_wall_count++] = d;
+    }
+  }
+
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  unsigned int new_goal_row = C;
+  unsigned int new_goal_col = C;
+  unsigned int new_goal_size = N;
+  if (goal == Solver::Goal::START) {
+    new_goal_row = 0;
+    new_goal_col = 0;
+    new_goal_size = 1;
+  }
+
+  start = mouse->getRow() * SIZE + mouse->getCol();
+  if (!searching || new_goal_row != goal_row || new_goal_col != goal_col || new_goal_size != goal_size) {
+    initialize(new_goal_row, new_goal_col, new_goal_size);
+  } else if (changed_wall_count > 0) {
+    km += heuristic(last, start);
+    last = start;
+    // only the cells on either side of a changed wall can have lost or gained a route, the rest is found from them
+    const uint16_t s = sr.row * SIZE + sr.col;
+    update_vertex(s);
+    for (unsigned int i = 0; i < changed_wall_count; i++) {
+      // the perimeter never changes, so the cell on the other side is always in the maze
+      update_vertex(s + smartmouse::maze::index_delta(changed_walls[i]));
+    }
+  }
+  compute_shortest_path();
+  total_nodes_expanded += nodes_expanded;
+
+  // walk downhill from the mouse, going straight when that's as short as turning.
+  // Cells far from the mouse can still be inconsistent, so the walk gives up after visiting every cell
+  no_wall_path.clear();
+  solvable = g[start] != INFINITE;
+  uint16_t s = start;
+  for (unsigned int steps = 0; solvable && !is_goal(s) && steps < CELLS; steps++) {
+    Direction best = Direction::INVALID;
+    uint16_t best_g = INFINITE;
+    const Direction facing = no_wall_path.empty() ? mouse->getDir() : no_wall_path.back().d;
+    for (const Direction d : {facing, Direction::N, Direction::E, Direction::S, Direction::W}) {
+      if (is_valid_dir(d) && !knowledge.optimistic.is_wall(s / SIZE, s % SIZE, d) &&
+          g[s + smartmouse::maze::index_delta(d)] < best_g) {
+        best = d;
+        best_g = g[s + smartmouse::maze::index_delta(d)];
+      }
+    }
+    if (best == Direction::INVALID) {
+      break;
+    }
+    insert_motion_primitive_back(&no_wall_path, {1, best});
+    s += smartmouse::maze::index_delta(best);
+  }
+  maze->path_to_next_goal = no_wall_path;
+
+  if (!solvable || no_wall_path.empty()) {
+    return {0, Direction::INVALID};
+  }
+
+  // go as far along the route as we know is open
+  route_t nextPath = maze->truncate(mouse->getRow(), mouse->getCol(), mouse->getDir(), no_wall_path);
+  return nextPath[0];
+}
+
+route_t DStarLite::solve() {
+  while (!isFinished()) {
+    mouse->internalTurnToFace(planNextStep().d);
+    mouse->internalForward();
+  }
+
+  // like Flood, the shortest route from the start to the center through walls we know are open.
+  // The route to run, which can be timed, is planned by teardown
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  route_t route;
+  knowledge.pessimistic_route(&route, 0, 0, C, C, N, N);
+  return route;
+}
+
+bool DStarLite::isFinished() {
+  unsigned int r = mouse->getRow();
+  unsigned int c = mouse->getCol();
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  if (goal == Solver::Goal::CENTER) {
+    return !solvable || (r - C < N && c - C < N);
+  } else if (goal == Solver::Goal::START) {
+    return !solvable || (r == 0 && c == 0);
+  } else {
+    return false;
+  }
+}
+
+void DStarLite::teardown() {
+  if (goal == Solver::Goal::CENTER) {
+    // these are from the start instead of the mouse, so they're flooded once here instead of kept up every step
+    const unsigned int C = smartmouse::maze::CENTER_CORNER;
+    const unsigned int N = smartmouse::maze::CENTER_CELLS;
+    DistanceField field;
+    field.compute(knowledge.optimistic, C, C, N, N);
+    field.route(knowledge.optimistic, &mouse->maze->fastest_theoretical_route, 0, 0);
+
+    // only known walls are open, so either route is safe to run
+    route_t timed_route;
+    if (timing && TimedRoutePlanner::plan(*timing, knowledge.pessimistic, &timed_route, nullptr, 0, 0, Direction::E,
+                                          C, C, N, N)) {
+      mouse->maze->fastest_route = timed_route;
+    } else {
+      field.compute(knowledge.pessimistic, C, C, N, N);
+      field.route(knowledge.pessimistic, &mouse->maze->fastest_route, 0, 0);
+    }
+  }
+}
@@ -0,0 +1,87 @@
+/** \brief explores from 0,0 like Flood, but keeps one D* Lite search from the goal back to the mouse between steps.
+ * The search only has to be right about the cells between the goal and wherever the mouse is,
+ * and when a sensed wall cuts one of the routes it was using, only the cells whose distance depended on that wall
+ * are looked at again. Moving doesn't invalidate anything, the keys of the open list are just offset by how far
+ * the mouse has moved since, which is km in the paper.
+ * Like AStar, the search state of every cell lives in fixed arrays in the solver.
+ */
+#pragma once
+
+#include "IndexedHeap.h"
+#include "Solver.h"
+#include "Mouse.h"
+#include "MazeKnowledge.h"
+#include "TimedRoutePlanner.h"
+
+class DStarLite : public Solver {
+
+public:
+
+  DStarLite(Mouse *mouse);
+
+  virtual void setup() override;
+
+  virtual motion_primitive_t planNextStep() override;
+
+  virtual route_t solve() override;
+
+  virtual void teardown() override;
+
+  virtual bool isFinished() override;
+
+  virtual void setGoal(Solver::Goal goal) override;
+
+  /** \brief see Flood::setRouteTiming */
+  void setRouteTiming(const route_timing_t *timing);
+
+  /** \brief cells taken off the open list by the last planNextStep */
+  unsigned int nodes_expanded;
+
+  /** \brief cells taken off the open list since the solver was made, to compare with Flood and AStar */
+  unsigned long total_nodes_expanded;
+
+private:
+  static constexpr unsigned int CELLS = smartmouse::maze::SIZE * smartmouse::maze::SIZE;
+  static constexpr uint16_t INFINITE = 0xFFFF;
+
+  /** \brief start over from the goal cells, for a new goal or a new run */
+  void initialize(unsigned int goal_row, unsigned int goal_col, unsigned int goal_size);
+
+  /** \brief the open list is ordered by the top half, then the bottom half, like the two part keys of the paper */
+  uint32_t calculate_key(uint16_t s) const;
+
+  /** \brief set rhs from the neighbors of s, and queue s if that makes it inconsistent */
+  void update_vertex(uint16_t s);
+
+  /** \brief expand cells until the mouse's cell is consistent and nothing queued could give it a shorter route */
+  void compute_shortest_path();
+
+  inline bool is_goal(uint16_t s) const {
+    return s / smartmouse::maze::SIZE - goal_row < goal_size && s % smartmouse::maze::SIZE - goal_col < goal_size;
+  }
+
+  /// \brief every wall is unknown, open, or a wall. The search is over the optimistic reading
+  MazeKnowledge knowledge;
+
+  route_t no_wall_path;
+  Solver::Goal goal;
+  const route_timing_t *timing;
+
+  /// \brief the goal the search was started from, which is searched again from scratch when it changes
+  bool searching;
+  unsigned int goal_row;
+  unsigned int goal_col;
+  unsigned int goal_size;
+
+  /// \brief the mouse's cell, and where it was the last time walls changed, which km has counted up to
+  uint16_t start;
+  uint16_t last;
+  uint16_t km;
+
+  /// \brief distance to the goal, and the one step lookahead of it from the neighbors
+  uint16_t g[CELLS];
+  uint16_t rhs[CELLS];
+
+  uint32_t key[CELLS];
+  IndexedHeap<uint32_t, CELLS> open;
+};
@@ -0,0 +1,204 @@
+#include "DiagonalRoute.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace {
+
+constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+constexpr unsigned int MAX_STEPS = SIZE * SIZE;
+
+/** \brief how far the point p is from the segment from a to b */
+double point_segment_distance(double py, double px, double ay, double ax, double by, double bx) {
+  const double dy = by - ay;
+  const double dx = bx - ax;
+  const double length_squared = dy * dy + dx * dx;
+  double t = 0;
+  if (length_squared > 0) {
+    t = std::max(0.0, std::min(1.0, ((py - ay) * dy + (px - ax) * dx) / length_squared));
+  }
+  return std::hypot(py - (ay + t * dy), px - (ax + t * dx));
+}
+
+/** \brief which side of the line through a and b the point p is on */
+double side(double py, double px, double ay, double ax, double by, double bx) {
+  return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+/** \brief how close the segments a to b and c to d get, which is 0 if they cross */
+double segment_distance(double ay, double ax, double by, double bx, double cy, double cx, double dy, double dx) {
+  const double c_side = side(cy, cx, ay, ax, by, bx);
+  const double d_side = side(dy, dx, ay, ax, by, bx);
+  const double a_side = side(ay, ax, cy, cx, dy, dx);
+  const double b_side = side(by, bx, cy, cx, dy, dx);
+  if (((c_side < 0 && d_side > 0) || (c_side > 0 && d_side < 0)) &&
+      ((a_side < 0 && b_side > 0) || (a_side > 0 && b_side < 0))) {
+    return 0;
+  }
+  return std::min({point_segment_distance(ay, ax, cy, cx, dy, dx), point_segment_distance(by, bx, cy, cx, dy, dx),
+                   point_segment_distance(cy, cx, ay, ax, by, bx), point_segment_distance(dy, dx, ay, ax, by, bx)});
+}
+
+/** \brief adds a move of half a cell, or half a cell diagonal, merging it with the last move if it goes the same way */
+void append_half_step(diagonal_route_t *route, int dy, int dx) {
+  diagonal_primitive_t prim{1, Direction::INVALID, Direction::INVALID};
+  if (dy != 0 && dx != 0) {
+    prim.d = dy < 0 ? Direction::N : Direction::S;
+    prim.diagonal = dx > 0 ? Direction::E : Direction::W;
+  } else if (dy != 0) {
+    prim.d = dy < 0 ? Direction::N : Direction::S;
+  } else {
+    prim.d = dx > 0 ? Direction::E : Direction::W;
+  }
+
+  if (!route->empty() && route->back().d == prim.d && route->back().diagonal == prim.diagonal) {
+    route->back().n++;
+  } else if (!route->full()) {
+    route->push_back(prim);
+  }
+}
+
+}
+
+double diagonal_primitive_t::length() const {
+  return is_diagonal() ? n * M_SQRT1_2 : n / 2.0;
+}
+
+unsigned int diagonal_primitive_t::octant() const {
+  if (!is_diagonal()) {
+    return 2 * static_cast<unsigned int>(d);
+  }
+  if (d == Direction::N) {
+    return diagonal == Direction::E ? 1 : 7;
+  }
+  return diagonal == Direction::E ? 3 : 5;
+}
+
+std::string diagonal_route_to_string(const diagonal_route_t &route) {
+  std::stringstream ss;
+  if (route.empty()) {
+    ss << "empty";
+  }
+
+  for (const diagonal_primitive_t &prim : route) {
+    ss << (int) prim.n << dir_to_char(prim.d);
+    if (prim.is_diagonal()) {
+      ss << dir_to_char(prim.diagonal);
+    }
+  }
+
+  return ss.str();
+}
+
+unsigned int DiagonalPlanner::plan(const MazeWalls &walls, const route_t &route, unsigned int row, unsigned int col,
+                                   double clearance, diagonal_route_t *out, unsigned int min_cells) {
+  out->clear();
+
+  // step k goes from cell k of the route to cell k + 1
+  Direction steps[MAX_STEPS];
+  uint8_t rows[MAX_STEPS + 1];
+  uint8_t cols[MAX_STEPS + 1];
+  unsigned int length = 0;
+  rows[0] = row;
+  cols[0] = col;
+  for (const motion_primitive_t &prim : route) {
+    for (unsigned int i = 0; i < prim.n && length < MAX_STEPS; i++) {
+      steps[length] = prim.d;
+      rows[length + 1] = rows[length] + dir_row_delta(prim.d);
+      cols[length + 1] = cols[length] + dir_col_delta(prim.d);
+      length++;
+    }
+  }
+
+  // a cell turns if the step into it and the step out of it are 90 degrees apart
+  auto turns = [&](unsigned int k) {
+    return k > 0 && k < length && steps[k] != steps[k - 1] && steps[k] != opposite_direction(steps[k - 1]);
+  };
+
+  // a staircase is cells a to b that all turn, alternating left and right, so the middles of the edges
+  // between them are all on one diagonal line
+  bool cut[MAX_STEPS + 1] = {};
+  unsigned int staircases = 0;
+  for (unsigned int a = 1; a < length;) {
+    if (!turns(a)) {
+      a++;
+      continue;
+    }
+    unsigned int b = a;
+    while (turns(b + 1) && steps[b + 1] == steps[b - 1]) {
+      b++;
+    }
+
+    if (b - a + 1 >= min_cells) {
+      const double y0 = (rows[a - 1] + rows[a]) / 2.0 + 0.5;
+      const double x0 = (cols[a - 1] + cols[a]) / 2.0 + 0.5;
+      const double y1 = (rows[b] + rows[b + 1]) / 2.0 + 0.5;
+      const double x1 = (cols[b] + cols[b + 1]) / 2.0 + 0.5;
+      if (clears_walls(walls, y0, x0, y1, x1, clearance)) {
+        std::fill(cut + a, cut + b + 1, true);
+        staircases++;
+      }
+    }
+    a = b + 1;
+  }
+
+  // walk the middles of the cells and the edges between them in half cells, skipping the middles of cut cells,
+  // so every step between them is half a cell straight or half a cell diagonal
+  int y = 2 * row + 1;
+  int x = 2 * col + 1;
+  for (unsigned int k = 0; k < length; k++) {
+    const int edge_y = rows[k] + rows[k + 1] + 1;
+    const int edge_x = cols[k] + cols[k + 1] + 1;
+    append_half_step(out, edge_y - y, edge_x - x);
+    y = edge_y;
+    x = edge_x;
+
+    if (!cut[k + 1]) {
+      const int middle_y = 2 * rows[k + 1] + 1;
+      const int middle_x = 2 * cols[k + 1] + 1;
+      append_half_step(out, middle_y - y, middle_x - x);
+      y = middle_y;
+      x = middle_x;
+    }
+  }
+
+  return staircases;
+}
+
+bool DiagonalPlanner::clears_walls(const MazeWalls &walls, double y0, double x0, double y1, double x1,
+                                   double clearance) {
+  const double keep_out = clearance + smartmouse::maze::HALF_WALL_THICKNESS_CU;
+  const int min_row = std::max(0, static_cast<int>(std::floor(std::min(y0, y1))) - 1);
+  const int max_row = std::min<int>(SIZE - 1, static_cast<int>(std::floor(std::max(y0, y1))) + 1);
+  const int min_col = std::max(0, static_cast<int>(std::floor(std::min(x0, x1))) - 1);
+  const int max_col = std::min<int>(SIZE - 1, static_cast<int>(std::floor(std::max(x0, x1))) + 1);
+
+  for (int r = min_row; r <= max_row; r++) {
+    for (int c = min_col; c <= max_col; c++) {
+      // the posts are there whether or not any walls are, and a post is the same as a wall with no length
+      for (int corner = 0; corner < 4; corner++) {
+        const double post_y = r + corner / 2;
+        const double post_x = c + corner % 2;
+        if (point_segment_distance(post_y, post_x, y0, x0, y1, x1) < keep_out) {
+          return false;
+        }
+      }
+
+      for (Direction d = Direction::First; d < Direction::Last; d++) {
+        if (!walls.is_wall(r, c, d)) {
+          continue;
+        }
+        // the wall runs between the two corners of the cell on side d
+        const double ay = r + (d == Direction::S);
+        const double ax = c + (d == Direction::E);
+        const double by = r + (d != Direction::N);
+        const double bx = c + (d != Direction::W);
+        if (segment_distance(y0, x0, y1, x1, ay, ax, by, bx) < keep_out) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
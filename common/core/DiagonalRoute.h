@@ -0,0 +1,60 @@
+/** \brief speed run routes that cut across zig-zags diagonally instead of turning 90 degrees in every cell.
+ * A route moving E, S, E, S crosses cell edges at their midpoints, and every second midpoint is in line,
+ * so the mouse can drive straight from the first edge to the last at 45 degrees.
+ * Straight moves are counted in half cells, so a move can end on a cell edge where a diagonal starts.
+ */
+#pragma once
+
+#include <string>
+
+#include "MazeWalls.h"
+#include "Route.h"
+
+struct diagonal_primitive_t {
+  /** \brief half cells for a straight move, or for a diagonal move the number of cells cut across,
+   * which are half a cell diagonal each, sqrt(2) / 2 cells long
+   */
+  uint8_t n;
+
+  /** \brief which way a straight move goes, or whether a diagonal move goes N or S */
+  Direction d;
+
+  /** \brief Direction::INVALID for a straight move, or whether a diagonal move goes E or W */
+  Direction diagonal;
+
+  inline bool is_diagonal() const {
+    return diagonal != Direction::INVALID;
+  }
+
+  /** \brief how long the move is, in cells */
+  double length() const;
+
+  /** \brief which way the move goes in eighths of a turn clockwise from N, so 1 is NE and 2 is E */
+  unsigned int octant() const;
+};
+
+/** \brief every move is at least half a cell, and a route can be two of those per cell */
+typedef RingBuffer<diagonal_primitive_t,
+                   round_up_to_power_of_two(2 * smartmouse::maze::SIZE * smartmouse::maze::SIZE)> diagonal_route_t;
+
+/** \brief like route_to_string, but in half cells, and with both directions for diagonals, like 3E4SE1S */
+std::string diagonal_route_to_string(const diagonal_route_t &route);
+
+class DiagonalPlanner {
+public:
+  /** \brief turn a route into moves that cut across every staircase with at least min_cells turns in a row.
+   * A staircase is only cut if the mouse, as a circle of radius clearance, stays clear of every post
+   * and every wall around it on the way across. Otherwise its cells are left as 90 degree turns.
+   * With a min_cells bigger than any route, this just gives the route again in half cells.
+   * \param row, col where the route starts
+   * \param clearance half the width of the mouse plus any margin, in cells
+   * \return how many staircases were cut
+   */
+  static unsigned int plan(const MazeWalls &walls, const route_t &route, unsigned int row, unsigned int col,
+                           double clearance, diagonal_route_t *out, unsigned int min_cells = 2);
+
+  /** \return whether a circle of radius clearance moving in a straight line from y0, x0 to y1, x1
+   * stays clear of the posts and walls within a cell of it. Positions are in cells, from the top left corner.
+   */
+  static bool clears_walls(const MazeWalls &walls, double y0, double x0, double y1, double x1, double clearance);
+};
@@ -1,5 +1,15 @@
+/** \brief the four directions the mouse can face, and what turning, flipping, and moving one cell does to them.
+ * It's all constexpr in the header, so it inlines into the flood fill and planning loops and works in static_assert.
+ * Directions go clockwise from N, so turning is adding 1 or 3 mod 4 and flipping is adding 2.
+ */
 #pragma once
 
+#include <math.h>
+
+#if !defined M_PI
+#define M_PI 3.14159265358979
+#endif
+
 enum class Direction {
   N, //0
   E, //1
@@ -10,38 +20,93 @@ enum class Direction {
   INVALID = -1
 };
 
-/** \brief returns the left of the given direction */
-Direction left_of_dir(Direction d);
-
-Direction right_of_dir(Direction d);
-
-char yaw_to_char(double yaw);
+/** \brief true for N, E, S and W, and false for Last and INVALID */
+constexpr bool is_valid_dir(Direction d) {
+  return static_cast<unsigned int>(d) < 4;
+}
 
-Direction yaw_to_dir(double yaw);
+/** \brief adds a quarter turn clockwise to d, without checking it's valid */
+constexpr Direction rotate_dir(Direction d, int quarter_turns) {
+  return static_cast<Direction>((static_cast<int>(d) + quarter_turns) & 3);
+}
 
-double dir_to_yaw(Direction d);
-
-char opposite_direction(char c);
-
-Direction int_to_dir(int i);
-
-/**
- * \brief increments the direction in the order N, E, S, W, N, ...
- */
-Direction operator++(Direction &dir, int);
+/** \brief returns the left of the given direction */
+constexpr Direction left_of_dir(Direction d) {
+  return is_valid_dir(d) ? rotate_dir(d, 3) : Direction::INVALID;
+}
 
-Direction operator--(Direction &dir, int);
+constexpr Direction right_of_dir(Direction d) {
+  return is_valid_dir(d) ? rotate_dir(d, 1) : Direction::INVALID;
+}
 
 /**
  * \brief returns the opposite direction of the input direction
  * \param d direction you want the opposite of
  * \return the opposite direction of d
  */
-Direction opposite_direction(Direction d);
+constexpr Direction opposite_direction(Direction d) {
+  return is_valid_dir(d) ? rotate_dir(d, 2) : Direction::INVALID;
+}
+
+/** \brief how many rows moving one cell in d goes, which is -1 for N since row 0 is the north edge */
+constexpr int dir_row_delta(Direction d) {
+  return is_valid_dir(d) && !(static_cast<int>(d) & 1) ? static_cast<int>(d) - 1 : 0;
+}
+
+/** \brief how many columns moving one cell in d goes, which is -1 for W */
+constexpr int dir_col_delta(Direction d) {
+  return is_valid_dir(d) && (static_cast<int>(d) & 1) ? 2 - static_cast<int>(d) : 0;
+}
+
+/** \brief yaw is clockwise from E, so N is -pi/2 and each direction after it is another quarter turn */
+constexpr double dir_to_yaw(Direction d) {
+  return is_valid_dir(d) ? (static_cast<int>(d) - 1) * M_PI / 2 : -999;
+}
+
+constexpr Direction yaw_to_dir(double yaw) {
+  return (-M_PI / 4 < yaw && yaw < M_PI / 4) ? Direction::E
+       : (M_PI / 4 < yaw && yaw < 3 * M_PI / 4) ? Direction::S
+       : (-3 * M_PI / 4 < yaw && yaw < -M_PI / 4) ? Direction::N
+       : Direction::W;
+}
 
 /** translate a Dir (integer 0=N 1=E 2=S 3=W) into the character representation*/
-char dir_to_char(Direction dir);
+constexpr char dir_to_char(Direction dir) {
+  return is_valid_dir(dir) ? "NESW"[static_cast<int>(dir)] : '\0';
+}
 
+constexpr char yaw_to_char(double yaw) {
+  return dir_to_char(yaw_to_dir(yaw));
+}
 
 /** translate a char into the direction representation*/
-Direction char_to_dir(char c);
+constexpr Direction char_to_dir(char c) {
+  return c == 'N' ? Direction::N
+       : c == 'E' ? Direction::E
+       : c == 'S' ? Direction::S
+       : c == 'W' ? Direction::W
+       : Direction::INVALID;
+}
+
+constexpr char opposite_direction(char c) {
+  return dir_to_char(opposite_direction(char_to_dir(c)));
+}
+
+constexpr Direction int_to_dir(int i) {
+  return (i < 0 || i > 3) ? Direction::INVALID : static_cast<Direction>(i);
+}
+
+/**
+ * \brief increments the direction in the order N, E, S, W, Last, so it can be used to loop over the directions.
+ * Last and INVALID stay as they are.
+ */
+inline Direction operator++(Direction &dir, int) {
+  dir = is_valid_dir(dir) ? static_cast<Direction>(static_cast<int>(dir) + 1) : dir;
+  return dir;
+}
+
+/** \brief decrements the direction in the order W, S, E, N, W, ..., and Last goes back to W */
+inline Direction operator--(Direction &dir, int) {
+  dir = is_valid_dir(dir) ? rotate_dir(dir, 3) : dir == Direction::Last ? Direction::W : Direction::INVALID;
+  return dir;
+}
@@ -0,0 +1,303 @@
+#include "DistanceField.h"
+
+namespace {
+
+constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+/** \brief index of the cell next to i in the given direction. Only call it when there's no wall in the way. */
+inline uint16_t neighbor_index(uint16_t i, Direction d) {
+  return i + smartmouse::maze::index_delta(d);
+}
+
+inline bool test_bit(const MazeWalls::row_bits_t *bits, uint16_t i) {
+  return (bits[i / SIZE] >> (i % SIZE)) & 1u;
+}
+
+inline void set_bit(MazeWalls::row_bits_t *bits, uint16_t i) {
+  bits[i / SIZE] |= (1u << (i % SIZE));
+}
+
+inline void clear_bit(MazeWalls::row_bits_t *bits, uint16_t i) {
+  bits[i / SIZE] &= ~(1u << (i % SIZE));
+}
+
+}
+
+constexpr uint16_t DistanceField::UNREACHABLE;
+
+DistanceField::DistanceField()
+    : valid(false), goal_row(0), goal_col(0), goal_rows(1), goal_cols(1), cells_updated(0) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    for (unsigned int c = 0; c < SIZE; c++) {
+      dist[r][c] = UNREACHABLE;
+    }
+  }
+}
+
+void DistanceField::compute(const MazeWalls &walls, unsigned int goal_row, unsigned int goal_col,
+                            unsigned int goal_rows, unsigned int goal_cols) {
+  this->goal_row = goal_row;
+  this->goal_col = goal_col;
+  this->goal_rows = goal_rows;
+  this->goal_cols = goal_cols;
+  valid = true;
+
+  for (unsigned int r = 0; r < SIZE; r++) {
+    for (unsigned int c = 0; c < SIZE; c++) {
+      dist[r][c] = UNREACHABLE;
+    }
+  }
+
+  cell_queue_t queue;
+  MazeWalls::row_bits_t queued[SIZE] = {};
+  // every goal cell is a source, so each cell ends up with the distance to whichever goal cell is nearest
+  for (unsigned int r = goal_row; r < goal_row + goal_rows; r++) {
+    for (unsigned int c = goal_col; c < goal_col + goal_cols; c++) {
+      dist[r][c] = 0;
+      queue.push_back(r * SIZE + c);
+      set_bit(queued, r * SIZE + c);
+    }
+  }
+
+  cells_updated = 0;
+  propagate(walls, queue, queued);
+}
+
+void DistanceField::wall_removed(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir) {
+  cells_updated = 0;
+  if (!valid || walls.is_wall(row, col, dir)) {
+    return;
+  }
+
+  const uint16_t a = row * SIZE + col;
+  const uint16_t b = neighbor_index(a, dir);
+  const uint16_t dist_a = dist[row][col];
+  const uint16_t dist_b = dist[b / SIZE][b % SIZE];
+
+  // whichever side is farther from the goal might now have a shortcut through the other
+  cell_queue_t queue;
+  MazeWalls::row_bits_t queued[SIZE] = {};
+  if (dist_a != UNREACHABLE && dist_a + 1 < dist_b) {
+    dist[b / SIZE][b % SIZE] = dist_a + 1;
+    queue.push_back(b);
+    set_bit(queued, b);
+  } else if (dist_b != UNREACHABLE && dist_b + 1 < dist_a) {
+    dist[row][col] = dist_b + 1;
+    queue.push_back(a);
+    set_bit(queued, a);
+  }
+
+  propagate(walls, queue, queued);
+}
+
+void DistanceField::wall_added(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir) {
+  cells_updated = 0;
+  if (!valid || !walls.is_wall(row, col, dir)) {
+    return;
+  }
+
+  // a wall on the perimeter has no cell on the other side
+  if ((dir == Direction::N && row == 0) || (dir == Direction::W && col == 0)
+      || (dir == Direction::S && row == SIZE - 1) || (dir == Direction::E && col == SIZE - 1)) {
+    return;
+  }
+
+  const uint16_t a = row * SIZE + col;
+  const uint16_t b = neighbor_index(a, dir);
+
+  // find every cell that has lost its only way to get one step closer to the goal
+  uint16_t affected_cells[SIZE * SIZE];
+  unsigned int affected_count = 0;
+  MazeWalls::row_bits_t affected[SIZE] = {};
+  cell_queue_t queue;
+
+  for (uint16_t i : {a, b}) {
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+    if (dist[r][c] != UNREACHABLE && dist[r][c] != 0 && !supported(walls, r, c, affected)) {
+      set_bit(affected, i);
+      affected_cells[affected_count++] = i;
+      queue.push_back(i);
+    }
+  }
+
+  while (!queue.empty()) {
+    const uint16_t i = queue.pop_front();
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+
+    // anyone that used this cell to get to the goal needs to find another way
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
+
+      const uint16_t j = neighbor_index(i, d);
+      const unsigned int jr = j / SIZE;
+      const unsigned int jc = j % SIZE;
+      if (!test_bit(affected, j) && dist[jr][jc] == dist[r][c] + 1 && !supported(walls, jr, jc, affected)) {
+        set_bit(affected, j);
+        affected_cells[affected_count++] = j;
+        queue.push_back(j);
+      }
+    }
+  }
+
+  // the affected cells start from the best unaffected neighbor they have, and then improve each other
+  MazeWalls::row_bits_t queued[SIZE] = {};
+  for (unsigned int k = 0; k < affected_count; k++) {
+    const uint16_t i = affected_cells[k];
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+    uint16_t best = UNREACHABLE;
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
+      const uint16_t j = neighbor_index(i, d);
+      const uint16_t dist_j = dist[j / SIZE][j % SIZE];
+      if (!test_bit(affected, j) && dist_j != UNREACHABLE && dist_j + 1 < best) {
+        best = dist_j + 1;
+      }
+    }
+
+    dist[r][c] = best;
+    if (best != UNREACHABLE) {
+      queue.push_back(i);
+      set_bit(queued, i);
+    }
+  }
+
+  propagate(walls, queue, queued);
+  cells_updated += affected_count;
+}
+
+bool DistanceField::supported(const MazeWalls &walls, unsigned int row, unsigned int col,
+                              const MazeWalls::row_bits_t *excluded) const {
+  const uint16_t i = row * SIZE + col;
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    if (walls.is_wall(row, col, d)) {
+      continue;
+    }
+    const uint16_t j = neighbor_index(i, d);
+    if (!test_bit(excluded, j) && dist[j / SIZE][j % SIZE] + 1 == dist[row][col]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DistanceField::propagate(const MazeWalls &walls, cell_queue_t &queue, MazeWalls::row_bits_t *queued) {
+  // a cell can be queued again if it finds a better distance after it was popped,
+  // but it's never in the queue twice at once so the queue can't overflow
+  while (!queue.empty()) {
+    const uint16_t i = queue.pop_front();
+    clear_bit(queued, i);
+    cells_updated++;
+
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+    const uint16_t next = dist[r][c] + 1;
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
+
+      const uint16_t j = neighbor_index(i, d);
+      uint16_t &dist_j = dist[j / SIZE][j % SIZE];
+      if (next < dist_j) {
+        dist_j = next;
+        if (!test_bit(queued, j)) {
+          set_bit(queued, j);
+          queue.push_back(j);
+        }
+      }
+    }
+  }
+}
+
+bool DistanceField::route(const MazeWalls &walls, route_t *path, unsigned int row, unsigned int col) const {
+  path->clear();
+
+  if (dist[row][col] == UNREACHABLE) {
+    return false;
+  }
+
+  unsigned int r = row;
+  unsigned int c = col;
+  while (dist[r][c] > 0) {
+    const Direction d = next_direction(walls, r, c, Direction::INVALID);
+    const uint16_t i = neighbor_index(r * SIZE + c, d);
+    r = i / SIZE;
+    c = i % SIZE;
+    insert_motion_primitive_back(path, {1, d});
+  }
+
+  return true;
+}
+
+Direction DistanceField::next_direction(const MazeWalls &walls, unsigned int row, unsigned int col,
+                                        Direction facing) const {
+  const uint16_t here = dist[row][col];
+  if (here == 0 || here == UNREACHABLE) {
+    return Direction::INVALID;
+  }
+
+  // the perimeter is always a wall, so any open side leads to a cell inside the maze
+  const uint16_t i = row * SIZE + col;
+  if (facing >= Direction::First && facing < Direction::Last && !walls.is_wall(row, col, facing)) {
+    const uint16_t j = neighbor_index(i, facing);
+    if (dist[j / SIZE][j % SIZE] == here - 1) {
+      return facing;
+    }
+  }
+
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    if (!walls.is_wall(row, col, d)) {
+      const uint16_t j = neighbor_index(i, d);
+      if (dist[j / SIZE][j % SIZE] == here - 1) {
+        return d;
+      }
+    }
+  }
+
+  // only happens if the field doesn't match the walls
+  return Direction::INVALID;
+}
+
+DistanceFieldCache::DistanceFieldCache() : cells_updated(0), next_slot(0) {}
+
+DistanceField &DistanceFieldCache::get(const MazeWalls &walls, unsigned int goal_row, unsigned int goal_col,
+                                       unsigned int goal_rows, unsigned int goal_cols) {
+  for (DistanceField &field : fields) {
+    if (field.has_goal(goal_row, goal_col, goal_rows, goal_cols)) {
+      return field;
+    }
+  }
+
+  DistanceField &field = fields[next_slot];
+  next_slot = (next_slot + 1) % SLOTS;
+  field.compute(walls, goal_row, goal_col, goal_rows, goal_cols);
+  cells_updated += field.cells_updated;
+  return field;
+}
+
+void DistanceFieldCache::wall_removed(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir) {
+  for (DistanceField &field : fields) {
+    field.wall_removed(walls, row, col, dir);
+    cells_updated += field.cells_updated;
+  }
+}
+
+void DistanceFieldCache::wall_added(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir) {
+  for (DistanceField &field : fields) {
+    field.wall_added(walls, row, col, dir);
+    cells_updated += field.cells_updated;
+  }
+}
+
+void DistanceFieldCache::invalidate() {
+  for (DistanceField &field : fields) {
+    field.valid = false;
+  }
+}
@@ -0,0 +1,126 @@
+/** \brief distance from every cell to the nearest cell of a goal, which can be repaired when walls change.
+ * The goal is a rectangle of cells, like the 2x2 center, and the flood starts from all of them at once.
+ * Instead of flooding the whole maze again after every sensor reading, only the cells whose distance
+ * depended on a changed wall are updated, in the spirit of LPA* and D* Lite.
+ * Once it's computed, any number of start cells can ask for their route or next move without flooding again.
+ */
+#pragma once
+
+#include "MazeWalls.h"
+#include "RingBuffer.h"
+#include "Route.h"
+
+class DistanceField {
+public:
+  static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+  /** \brief starts out invalid, call compute() before using it */
+  DistanceField();
+
+  /** \brief flood the whole maze from scratch, starting at every goal cell
+   * \param goal_row the top row of the goal
+   * \param goal_col the left column of the goal
+   */
+  void compute(const MazeWalls &walls, unsigned int goal_row, unsigned int goal_col, unsigned int goal_rows = 1,
+               unsigned int goal_cols = 1);
+
+  /** \brief repair the field after the wall on the dir side of row, col was knocked down.
+   * Distances can only shrink, so we only need to spread out from the two cells on either side of the wall.
+   * \param walls the walls after the change
+   */
+  void wall_removed(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir);
+
+  /** \brief repair the field after a wall was put up on the dir side of row, col.
+   * First we find every cell whose shortest path went through the new wall, then we give those cells the best
+   * distance their other neighbors can offer and spread out from there.
+   * \param walls the walls after the change
+   */
+  void wall_added(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir);
+
+  /** \return the number of steps from row, col to the nearest goal cell, or UNREACHABLE */
+  inline uint16_t distance(unsigned int row, unsigned int col) const {
+    return dist[row][col];
+  }
+
+  /** \return whether row, col is one of the goal cells */
+  inline bool is_goal(unsigned int row, unsigned int col) const {
+    return valid && row - goal_row < goal_rows && col - goal_col < goal_cols;
+  }
+
+  /** \return whether this field was computed for exactly this goal */
+  inline bool has_goal(unsigned int row, unsigned int col, unsigned int rows, unsigned int cols) const {
+    return valid && row == goal_row && col == goal_col && rows == goal_rows && cols == goal_cols;
+  }
+
+  /** \brief the route from row, col to the goal, found by stepping downhill one cell at a time.
+   * At each step N, E, S, then W is tried, so the route is the same for the same field.
+   * This takes as many steps as the route is long, and never floods.
+   * \param walls the walls the field was computed or repaired for
+   * \return false and an empty path if row, col can't reach the goal
+   */
+  bool route(const MazeWalls &walls, route_t *path, unsigned int row, unsigned int col) const;
+
+  /** \brief which way to go from row, col to get one step closer to the goal.
+   * Going straight is preferred when it's as short as turning, otherwise N, E, S, then W is tried.
+   * \param walls the walls the field was computed or repaired for
+   * \param facing the direction the mouse is facing, or Direction::INVALID to not prefer any
+   * \return Direction::INVALID at the goal, or if the goal can't be reached
+   */
+  Direction next_direction(const MazeWalls &walls, unsigned int row, unsigned int col, Direction facing) const;
+
+  bool valid;
+  unsigned int goal_row;
+  unsigned int goal_col;
+  unsigned int goal_rows;
+  unsigned int goal_cols;
+
+  /** \brief how many cells the last compute or repair had to look at, used to measure how much work was saved */
+  unsigned int cells_updated;
+
+  uint16_t dist[smartmouse::maze::SIZE][smartmouse::maze::SIZE];
+
+private:
+  typedef RingBuffer<uint16_t, round_up_to_power_of_two(smartmouse::maze::SIZE * smartmouse::maze::SIZE)>
+      cell_queue_t;
+
+  /** \brief relax distances outward from the cells in the queue until nothing changes
+   * \param queued one bit per cell, set for the cells that are in the queue
+   */
+  void propagate(const MazeWalls &walls, cell_queue_t &queue, MazeWalls::row_bits_t *queued);
+
+  /** \return whether any open neighbor of row, col that isn't excluded is one step closer to the goal */
+  bool supported(const MazeWalls &walls, unsigned int row, unsigned int col,
+                 const MazeWalls::row_bits_t *excluded) const;
+};
+
+/** \brief distance fields for the last few goals over the same walls, repaired together when a wall changes */
+class DistanceFieldCache {
+public:
+  /** \brief enough for the current goal and the center, which is what Flood needs */
+  static constexpr unsigned int SLOTS = 2;
+
+  DistanceFieldCache();
+
+  /** \brief get the field for a goal, computing it if we don't have one for that goal yet.
+   * When every slot is taken the oldest goal is forgotten.
+   */
+  DistanceField &get(const MazeWalls &walls, unsigned int goal_row, unsigned int goal_col, unsigned int goal_rows = 1,
+                     unsigned int goal_cols = 1);
+
+  /** \brief see DistanceField::wall_removed */
+  void wall_removed(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir);
+
+  /** \brief see DistanceField::wall_added */
+  void wall_added(const MazeWalls &walls, unsigned int row, unsigned int col, Direction dir);
+
+  /** \brief forget every field, for when the walls were changed without telling us */
+  void invalidate();
+
+  DistanceField fields[SLOTS];
+
+  /** \brief how many cells every compute and repair so far had to look at, to compare against other searches */
+  unsigned long cells_updated;
+
+private:
+  unsigned int next_slot;
+};
@@ -1,74 +1,81 @@
 #include "Flood.h"
 
-Flood::Flood(Mouse *mouse) : Solver(mouse), done(false), solved(false) {}
+Flood::Flood(Mouse *mouse) : Solver(mouse), done(false), timing(nullptr), solved(false) {}
 
 //starts at 0, 0 and explores the whole maze
 void Flood::setup() {
   mouse->reset();
   mouse->maze->reset();
   all_wall_maze = mouse->maze;
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER, smartmouse::maze::CENTER, Direction::W);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER, smartmouse::maze::CENTER, Direction::N);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER - 1, smartmouse::maze::CENTER - 1, Direction::E);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER - 1, smartmouse::maze::CENTER - 1, Direction::S);
-  no_wall_maze.connect_all_neighbors_in_maze();
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER, smartmouse::maze::CENTER, Direction::W);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER, smartmouse::maze::CENTER, Direction::N);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER - 1, smartmouse::maze::CENTER - 1, Direction::E);
-  all_wall_maze->connect_neighbor(smartmouse::maze::CENTER - 1, smartmouse::maze::CENTER - 1, Direction::S);
+
+  //routes are only reused while the walls they were planned in haven't changed
+  route_cache.clear();
+  knowledge.route_cache = &route_cache;
+
+  knowledge.reset();
+  all_wall_maze->set_walls(knowledge.pessimistic);
   goal = Solver::Goal::CENTER;
 }
 
+const RouteCache &Flood::getRouteCache() const {
+  return route_cache;
+}
+
+unsigned long Flood::getCellsUpdated() const {
+  return knowledge.cells_updated();
+}
+
+void Flood::setRouteTiming(const route_timing_t *timing) {
+  this->timing = timing;
+}
+
 void Flood::setGoal(Solver::Goal goal) {
   this->goal = goal;
 }
 
 motion_primitive_t Flood::planNextStep() {
-  //mark the nodes visted in both the mazes
-  no_wall_maze.mark_position_visited(mouse->getRow(), mouse->getCol());
   all_wall_maze->mark_position_visited(mouse->getRow(), mouse->getCol());
 
   //check left right back and front sides
   //eventually this will return values from sensors
   SensorReading sr = mouse->checkWalls();
 
-  //update the mazes base on that reading
-  no_wall_maze.update(sr);
-  all_wall_maze->update(sr);
-
-  //solve flood fill on the two mazes from mouse to goal
-  switch (goal) {
-    case Solver::Goal::CENTER: {
-      solvable = no_wall_maze.flood_fill_from_point(&no_wall_path, mouse->getRow(), mouse->getCol(),
-                                                    smartmouse::maze::CENTER, smartmouse::maze::CENTER);
-      //this way commands can see this used to visualize in gazebo
-      mouse->maze->path_to_next_goal = no_wall_path;
-      all_wall_maze->flood_fill_from_point(&all_wall_path, mouse->getRow(), mouse->getCol(), smartmouse::maze::CENTER,
-                                                    smartmouse::maze::CENTER);
-      break;
-    }
-    case Solver::Goal::START: {
-      solvable = no_wall_maze.flood_fill_from_point(&no_wall_path, mouse->getRow(), mouse->getCol(), 0, 0);
-      //this way commands can see this used to visualize in gazebo
-      mouse->maze->path_to_next_goal = no_wall_path;
-      all_wall_maze->flood_fill_from_point(&all_wall_path, mouse->getRow(), mouse->getCol(), 0, 0);
-      break;
-    }
+  //the mouse's maze is always the pessimistic reading of what we know, so everyone else sees known walls only
+  knowledge.update(sr);
+  all_wall_maze->set_walls(knowledge.pessimistic);
+
+  //any of the four center cells will do, so they're all flooded from at once
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  unsigned int goal_row = C;
+  unsigned int goal_col = C;
+  unsigned int goal_size = N;
+  if (goal == Solver::Goal::START) {
+    goal_row = 0;
+    goal_col = 0;
+    goal_size = 1;
   }
 
+  //route to the goal assuming unknown walls are open
+  solvable = knowledge.optimistic_route(&no_wall_path, mouse->getRow(), mouse->getCol(), goal_row, goal_col,
+                                        goal_size, goal_size);
+  //this way commands can see this used to visualize in gazebo
+  mouse->maze->path_to_next_goal = no_wall_path;
+
   //solve from origin to center
   //this is what tells us whether or not we need to keep searching
-  no_wall_maze.flood_fill_from_origin_to_center(&no_wall_maze.fastest_route);
-  all_wall_maze->flood_fill_from_origin_to_center(&all_wall_maze->fastest_route);
+  knowledge.optimistic_route(&mouse->maze->fastest_theoretical_route, 0, 0, C, C, N, N);
+  knowledge.pessimistic_route(&all_wall_maze->fastest_route, 0, 0, C, C, N, N);
 
-  //this way commands can see this
-  //used to visualize in gazebo
-  mouse->maze->fastest_theoretical_route = no_wall_maze.fastest_route;
+  //there's nowhere to go if the goal is walled off or we're already there
+  if (!solvable || no_wall_path.empty()) {
+    return {0, Direction::INVALID};
+  }
 
   // Walk along the no_wall_path as far as possible in the all_wall_maze
   // This will results in the longest path where we know there are no walls
   route_t nextPath = all_wall_maze->truncate(mouse->getRow(), mouse->getCol(), mouse->getDir(), no_wall_path);
-  return nextPath.at(0);
+  return nextPath[0];
 }
 
 route_t Flood::solve() {
@@ -84,9 +91,10 @@ route_t Flood::solve() {
 bool Flood::isFinished() {
   unsigned int r = mouse->getRow();
   unsigned int c = mouse->getCol();
-  const unsigned int C = smartmouse::maze::SIZE / 2;
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
   if (goal == Solver::Goal::CENTER) {
-    return !solvable || ((r >= C - 1 && r <= C) && (c >= C - 1 && c <= C));
+    return !solvable || (r - C < N && c - C < N);
   } else if (goal == Solver::Goal::START) {
     return !solvable || (r == 0 && c == 0);
   } else {
@@ -98,5 +106,14 @@ void Flood::teardown() {
   //this is the final solution which represents how the mouse should travel from start to finish
   if (goal == Solver::Goal::CENTER) {
     mouse->maze->fastest_route = all_wall_maze->fastest_route;
+
+    // only known walls are open, so the route is safe to run. The mouse starts the run facing the way it's reset to
+    const unsigned int C = smartmouse::maze::CENTER_CORNER;
+    const unsigned int N = smartmouse::maze::CENTER_CELLS;
+    route_t timed_route;
+    if (timing && TimedRoutePlanner::plan(*timing, all_wall_maze->walls, &timed_route, nullptr, 0, 0, Direction::E,
+                                          C, C, N, N)) {
+      mouse->maze->fastest_route = timed_route;
+    }
   }
 }
@@ -1,14 +1,16 @@
 /** \brief starts at 0,0 and explores the whole maze.
  * kmaze is the known maze, and is used to "read the sensors".
  * The mouse solves the maze after sensing each new square.
- * solves assuming ALL walls, and assuming NO walls.
- * when the solution for those two mazes are the same,
+ * solves assuming ALL unknown walls are there, and assuming NONE of them are.
+ * when the solution for those two are the same,
  * then it knows the fastest route.
  */
 #pragma once
 
 #include "Solver.h"
 #include "Mouse.h"
+#include "MazeKnowledge.h"
+#include "TimedRoutePlanner.h"
 
 class Flood : public Solver {
 
@@ -28,19 +30,33 @@ public:
 
   virtual void setGoal(Solver::Goal goal) override;
 
+  /** \brief routes the knowledge reused instead of planning again, because the walls hadn't changed since */
+  const RouteCache &getRouteCache() const;
+
+  /** \brief how many cells flooding and repairing has looked at since the solver was made, to compare with AStar */
+  unsigned long getCellsUpdated() const;
+
+  /** \brief when set, teardown picks the fastest route by the seconds it's predicted to take with this timing,
+   * instead of by how many cells it has. It has to outlive the solver.
+   */
+  void setRouteTiming(const route_timing_t *timing);
+
   bool done;
 
 private:
 
-  /// \brief this maze is initially no walls, and walls are filled out every time the mouse moves
-  AbstractMaze no_wall_maze;
+  /// \brief every wall is unknown, open, or a wall. Both the routes with and without the unknown walls come from here
+  MazeKnowledge knowledge;
 
-  /// \brief this maze is initially all walls, and walls are removed every time the mouse moves
+  /// \brief the mouse's maze, kept equal to the pessimistic reading of the knowledge so other code can use it
   AbstractMaze *all_wall_maze;
 
+  /// \brief only the knowledge uses it, since ReturnToStart and SpeedRun follow the mouse's distance fields instead
+  RouteCache route_cache;
+
   route_t no_wall_path;
-  route_t all_wall_path;
   Solver::Goal goal;
+  const route_timing_t *timing;
 
   bool solved;
 };
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+
+/**
+ * \brief a binary min heap of the indices 0 to N - 1, ordered by cost[index], that knows where each index is
+ * so its cost can be lowered while it's queued. Everything lives in fixed arrays, so it never touches the heap.
+ * The costs belong to the caller, and are only read.
+ */
+template<typename Cost, unsigned int N>
+class IndexedHeap {
+  static_assert(N < 0xFFFE, "indices have to fit in 16 bits, with two values left over");
+
+public:
+  static constexpr uint16_t NOT_QUEUED = 0xFFFF;
+  static constexpr uint16_t POPPED = 0xFFFE;
+
+  explicit IndexedHeap(const Cost *cost) : cost(cost), count(0) {
+    std::fill(pos, pos + N, NOT_QUEUED);
+  }
+
+  inline bool empty() const {
+    return count == 0;
+  }
+
+  /** \brief forget every index, as if it was just made */
+  void clear() {
+    count = 0;
+    std::fill(pos, pos + N, NOT_QUEUED);
+  }
+
+  /** \return whether i is in the heap right now */
+  inline bool queued(uint16_t i) const {
+    return pos[i] < count;
+  }
+
+  /** \return the index with the lowest cost, which the heap must not be empty for */
+  inline uint16_t top() const {
+    return heap[0];
+  }
+
+  /** \return whether i was popped since it was last queued */
+  inline bool popped(uint16_t i) const {
+    return pos[i] == POPPED;
+  }
+
+  /** \brief call after lowering the cost of i, whether or not it's queued yet */
+  void push_or_lower(uint16_t i) {
+    if (pos[i] == NOT_QUEUED || pos[i] == POPPED) {
+      pos[i] = count;
+      heap[count++] = i;
+    }
+    sift_up(pos[i]);
+  }
+
+  uint16_t pop() {
+    const uint16_t first = heap[0];
+    pos[first] = POPPED;
+    if (--count > 0) {
+      heap[0] = heap[count];
+      pos[heap[0]] = 0;
+      sift_down(0);
+    }
+    return first;
+  }
+
+  /** \brief call after changing the cost of a queued i, whether it went up or down */
+  void update(uint16_t i) {
+    sift_up(pos[i]);
+    sift_down(pos[i]);
+  }
+
+  /** \brief take a queued i out of the heap, so it can be pushed again later */
+  void remove(uint16_t i) {
+    const uint16_t h = pos[i];
+    pos[i] = NOT_QUEUED;
+    if (h < --count) {
+      const uint16_t moved = heap[count];
+      place(h, moved);
+      update(moved);
+    }
+  }
+
+private:
+  void place(uint16_t h, uint16_t i) {
+    heap[h] = i;
+    pos[i] = h;
+  }
+
+  void sift_up(uint16_t h) {
+    const uint16_t i = heap[h];
+    while (h > 0 && cost[i] < cost[heap[(h - 1) / 2]]) {
+      place(h, heap[(h - 1) / 2]);
+      h = (h - 1) / 2;
+    }
+    place(h, i);
+  }
+
+  void sift_down(uint16_t h) {
+    const uint16_t i = heap[h];
+    while (2 * h + 1 < count) {
+      uint16_t child = 2 * h + 1;
+      if (child + 1 < count && cost[heap[child + 1]] < cost[heap[child]]) {
+        child++;
+      }
+      if (!(cost[heap[child]] < cost[i])) {
+        break;
+      }
+      place(h, heap[child]);
+      h = child;
+    }
+    place(h, i);
+  }
+
+  const Cost *cost;
+  uint16_t heap[N];
+  uint16_t pos[N];
+  uint16_t count;
+};
+
+template<typename Cost, unsigned int N>
+constexpr uint16_t IndexedHeap<Cost, N>::NOT_QUEUED;
+
+template<typename Cost, unsigned int N>
+constexpr uint16_t IndexedHeap<Cost, N>::POPPED;
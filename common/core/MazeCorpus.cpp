@@ -0,0 +1,207 @@
+#ifndef ARDUINO
+
+#include "MazeCorpus.h"
+
+#include <fstream>
+
+#include "MazeParser.h"
+
+#ifdef _WIN32
+#include <algorithm>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/** \brief MazeWalls is made of row words, so it has to start on a multiple of the largest one */
+constexpr uint64_t WALLS_ALIGNMENT = 8;
+
+uint64_t align(uint64_t offset) {
+  return (offset + WALLS_ALIGNMENT - 1) & ~(WALLS_ALIGNMENT - 1);
+}
+
+}
+
+constexpr uint32_t MazeCorpus::MAGIC;
+constexpr uint16_t MazeCorpus::VERSION;
+
+void MazeCorpusWriter::add(const MazeWalls &walls, const std::string &name, const std::string &metadata) {
+  this->walls.push_back(walls);
+  names.push_back(name);
+  this->metadata.push_back(metadata);
+}
+
+bool MazeCorpusWriter::add_mz(const std::string &mz_file) {
+  std::vector<MazeWalls> mazes;
+  try {
+    mazes = MazeParser::parse_file(mz_file);
+  }
+  catch (MazeParseError &e) {
+    return false;
+  }
+
+  for (const MazeWalls &maze_walls : mazes) {
+    add(maze_walls, mz_file);
+  }
+  return !mazes.empty();
+}
+
+unsigned int MazeCorpusWriter::count() const {
+  return walls.size();
+}
+
+bool MazeCorpusWriter::save(const std::string &corpus_file) const {
+  MazeCorpus::header_t header = {};
+  header.magic = MazeCorpus::MAGIC;
+  header.version = MazeCorpus::VERSION;
+  header.size = smartmouse::maze::SIZE;
+  header.walls_bytes = sizeof(MazeWalls);
+  header.count = walls.size();
+  header.walls_offset = align(sizeof(header));
+  header.index_offset = align(header.walls_offset + walls.size() * sizeof(MazeWalls));
+
+  std::vector<MazeCorpus::index_t> index(walls.size());
+  uint64_t strings_offset = header.index_offset + index.size() * sizeof(MazeCorpus::index_t);
+  for (unsigned int i = 0; i < walls.size(); i++) {
+    index[i].name_offset = strings_offset;
+    index[i].name_length = names[i].size();
+    index[i].metadata_length = metadata[i].size();
+    strings_offset += names[i].size() + metadata[i].size();
+  }
+
+  std::ofstream fs;
+  fs.open(corpus_file, std::ofstream::out | std::ofstream::binary);
+  if (!fs.good()) {
+    return false;
+  }
+
+  const char padding[WALLS_ALIGNMENT] = {};
+  fs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  fs.write(padding, header.walls_offset - sizeof(header));
+  fs.write(reinterpret_cast<const char *>(walls.data()), walls.size() * sizeof(MazeWalls));
+  fs.write(padding, header.index_offset - (header.walls_offset + walls.size() * sizeof(MazeWalls)));
+  fs.write(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(MazeCorpus::index_t));
+  for (unsigned int i = 0; i < walls.size(); i++) {
+    fs << names[i] << metadata[i];
+  }
+
+  return fs.good();
+}
+
+MazeCorpusReader::MazeCorpusReader() : data(nullptr), length(0), header(nullptr), index(nullptr) {}
+
+MazeCorpusReader::~MazeCorpusReader() {
+  close();
+}
+
+bool MazeCorpusReader::open(const std::string &corpus_file) {
+  close();
+
+#ifdef _WIN32
+  // no mmap, so read the whole thing in one go instead
+  std::ifstream fs(corpus_file, std::ifstream::in | std::ifstream::binary);
+  if (!fs.good()) {
+    return false;
+  }
+  std::vector<char> contents((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  uint8_t *buffer = new uint8_t[contents.size()];
+  std::copy(contents.begin(), contents.end(), buffer);
+  data = buffer;
+  length = contents.size();
+#else
+  int fd = ::open(corpus_file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapped == MAP_FAILED) {
+    return false;
+  }
+  data = static_cast<const uint8_t *>(mapped);
+  length = st.st_size;
+#endif
+
+  header = reinterpret_cast<const MazeCorpus::header_t *>(data);
+  bool ok = length >= sizeof(MazeCorpus::header_t)
+            && header->magic == MazeCorpus::MAGIC
+            && header->version == MazeCorpus::VERSION
+            && header->size == smartmouse::maze::SIZE
+            && header->walls_bytes == sizeof(MazeWalls)
+            && header->walls_offset % WALLS_ALIGNMENT == 0
+            && header->walls_offset + (uint64_t) header->count * sizeof(MazeWalls) <= length
+            && header->index_offset + (uint64_t) header->count * sizeof(MazeCorpus::index_t) <= length;
+  if (!ok) {
+    close();
+    return false;
+  }
+
+  index = reinterpret_cast<const MazeCorpus::index_t *>(data + header->index_offset);
+  return true;
+}
+
+void MazeCorpusReader::close() {
+  if (data != nullptr) {
+#ifdef _WIN32
+    delete[] data;
+#else
+    munmap(const_cast<uint8_t *>(data), length);
+#endif
+  }
+  data = nullptr;
+  length = 0;
+  header = nullptr;
+  index = nullptr;
+}
+
+unsigned int MazeCorpusReader::count() const {
+  return header == nullptr ? 0 : header->count;
+}
+
+const MazeWalls &MazeCorpusReader::walls(unsigned int i) const {
+  return reinterpret_cast<const MazeWalls *>(data + header->walls_offset)[i];
+}
+
+std::string MazeCorpusReader::name(unsigned int i) const {
+  const MazeCorpus::index_t &entry = index[i];
+  if (entry.name_offset + entry.name_length > length) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char *>(data + entry.name_offset), entry.name_length);
+}
+
+std::string MazeCorpusReader::metadata(unsigned int i) const {
+  const MazeCorpus::index_t &entry = index[i];
+  const uint64_t offset = entry.name_offset + entry.name_length;
+  if (offset + entry.metadata_length > length) {
+    return "";
+  }
+  return std::string(reinterpret_cast<const char *>(data + offset), entry.metadata_length);
+}
+
+AbstractMaze MazeCorpusReader::maze(unsigned int i) const {
+  AbstractMaze maze;
+  maze.set_walls(walls(i));
+  return maze;
+}
+
+std::string MazeCorpusReader::mz(unsigned int i) const {
+  std::string buff;
+  buff.resize(smartmouse::maze::BUFF_SIZE);
+  maze(i).print_maze_str(&buff[0]);
+  return std::string(buff.c_str());
+}
+
+#endif
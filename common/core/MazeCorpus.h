@@ -0,0 +1,100 @@
+/** \brief many mazes in one binary file, for regression and tuning runs over far more mazes than .mz files can hold.
+ * The file is a header, then the walls of every maze back to back, then an index table, then the names and metadata.
+ * Each maze's walls are stored exactly as a MazeWalls is laid out in memory, so the reader maps the file and hands out
+ * pointers into it without copying or parsing anything. This means a corpus can only be read by a build with the same
+ * MAZE_SIZE and byte order as the one that wrote it, and the header is checked for that.
+ */
+#pragma once
+
+#ifndef ARDUINO // there's no file system on arduino
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "AbstractMaze.h"
+#include "MazeWalls.h"
+
+class MazeCorpus {
+public:
+  static constexpr uint32_t MAGIC = 0x435A4D53; // "SMZC" in a little endian file
+  static constexpr uint16_t VERSION = 1;
+
+  struct header_t {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size; // smartmouse::maze::SIZE of the build that wrote it
+    uint32_t walls_bytes; // sizeof(MazeWalls) of the build that wrote it
+    uint32_t count;
+    uint64_t walls_offset;
+    uint64_t index_offset;
+  };
+
+  /** \brief where to find the name and metadata of one maze, both are optional */
+  struct index_t {
+    uint64_t name_offset;
+    uint32_t name_length;
+    uint32_t metadata_length; // the metadata comes right after the name
+  };
+};
+
+/** \brief collects mazes in memory and then writes them all to a corpus file */
+class MazeCorpusWriter {
+public:
+  void add(const MazeWalls &walls, const std::string &name = "", const std::string &metadata = "");
+
+  /** \brief add every maze in a .mz file, each named after the file
+   * \return false, and add nothing, if the file can't be opened or has a maze that isn't valid
+   */
+  bool add_mz(const std::string &mz_file);
+
+  unsigned int count() const;
+
+  /** \return false if the file can't be written */
+  bool save(const std::string &corpus_file) const;
+
+private:
+  std::vector<MazeWalls> walls;
+  std::vector<std::string> names;
+  std::vector<std::string> metadata;
+};
+
+/** \brief memory maps a corpus file, so opening it costs the same no matter how many mazes are in it */
+class MazeCorpusReader {
+public:
+  MazeCorpusReader();
+
+  ~MazeCorpusReader();
+
+  MazeCorpusReader(const MazeCorpusReader &) = delete;
+
+  MazeCorpusReader &operator=(const MazeCorpusReader &) = delete;
+
+  /** \return false if the file can't be mapped, or wasn't written by a build with the same maze size */
+  bool open(const std::string &corpus_file);
+
+  void close();
+
+  unsigned int count() const;
+
+  /** \brief the walls of the i'th maze, pointing right into the mapped file */
+  const MazeWalls &walls(unsigned int i) const;
+
+  std::string name(unsigned int i) const;
+
+  std::string metadata(unsigned int i) const;
+
+  /** \brief copy the i'th maze into a maze that can be flooded and solved */
+  AbstractMaze maze(unsigned int i) const;
+
+  /** \brief the i'th maze as the text of a .mz file, see AbstractMaze::print_maze_str */
+  std::string mz(unsigned int i) const;
+
+private:
+  const uint8_t *data;
+  size_t length;
+  const MazeCorpus::header_t *header;
+  const MazeCorpus::index_t *index;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "MazeFeatures.h"
+
+#include <algorithm>
+
+#include "RingBuffer.h"
+
+namespace {
+
+/** \brief the longest run of set bits, found by shortening every run by one until none are left */
+unsigned int longest_run(unsigned int bits) {
+  unsigned int run = 0;
+  while (bits) {
+    bits &= bits << 1;
+    run++;
+  }
+  return run;
+}
+
+constexpr uint16_t UNREACHED = 0xFFFF;
+
+/** \brief index of the next cell over from cell i, which has to have no wall that way */
+uint16_t neighbor(uint16_t i, Direction d) {
+  return i + smartmouse::maze::index_delta(d);
+}
+
+}
+
+maze_features_t MazeFeatures::analyze(const AbstractMaze &maze) {
+  return analyze(maze.walls);
+}
+
+maze_features_t MazeFeatures::analyze(const MazeWalls &walls) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  constexpr unsigned int FULL_ROW = MazeWalls::FULL_ROW;
+  maze_features_t features = {};
+
+  // dead ends, open walls, and straights along the rows come a row of cells at a time.
+  // The columns of the maze are the rows of its mirror image, so that gives the straights along the columns
+  const MazeWalls mirror = walls.transposed();
+  unsigned int open_walls = 0;
+  for (unsigned int r = 0; r < SIZE; r++) {
+    const unsigned int open_n = r == 0 ? 0 : ~walls.horizontal[r - 1] & FULL_ROW;
+    const unsigned int open_e = ~walls.vertical[r] & FULL_ROW;
+    const unsigned int open_s = ~walls.horizontal[r] & FULL_ROW;
+    const unsigned int open_w = (open_e << 1) & FULL_ROW;
+
+    const unsigned int any_open = open_n | open_e | open_s | open_w;
+    const unsigned int two_open = (open_n & (open_e | open_s | open_w)) | (open_e & (open_s | open_w))
+                                  | (open_s & open_w);
+    features.dead_ends += __builtin_popcount(any_open & ~two_open);
+
+    open_walls += __builtin_popcount(open_e) + __builtin_popcount(open_s);
+
+    // a run of n open walls joins n + 1 cells
+    const unsigned int open_down_column = ~mirror.vertical[r] & FULL_ROW;
+    features.longest_straight = std::max({features.longest_straight, longest_run(open_e) + 1,
+                                          longest_run(open_down_column) + 1});
+  }
+
+  // breadth first search from the start. Every cell is popped after all the cells one closer to the start,
+  // so by then its route count and turns are final and can be passed on to the cells one farther away
+  uint16_t distance[SIZE * SIZE];
+  uint64_t routes[SIZE * SIZE];
+  uint16_t turns[SIZE * SIZE][4]; // fewest turns on a shortest route that arrives heading each way
+  std::fill(distance, distance + SIZE * SIZE, UNREACHED);
+  std::fill(routes, routes + SIZE * SIZE, 0);
+  std::fill(&turns[0][0], &turns[0][0] + SIZE * SIZE * 4, UNREACHED);
+
+  // leaving the start in any direction isn't a turn
+  distance[0] = 0;
+  routes[0] = 1;
+  std::fill(turns[0], turns[0] + 4, 0);
+
+  RingBuffer<uint16_t, round_up_to_power_of_two(SIZE * SIZE)> frontier;
+  frontier.push_back(0);
+  while (!frontier.empty()) {
+    const uint16_t i = frontier.pop_front();
+    const unsigned int r = i / SIZE;
+    const unsigned int c = i % SIZE;
+
+    for (Direction d = Direction::First; d < Direction::Last; d++) {
+      if (walls.is_wall(r, c, d)) {
+        continue;
+      }
+      const uint16_t j = neighbor(i, d);
+      if (distance[j] == UNREACHED) {
+        distance[j] = distance[i] + 1;
+        frontier.push_back(j);
+      }
+      if (distance[j] != distance[i] + 1) {
+        continue;
+      }
+
+      routes[j] += routes[i];
+      const int out = static_cast<int>(d);
+      for (int in = 0; in < 4; in++) {
+        if (turns[i][in] != UNREACHED) {
+          const uint16_t t = turns[i][in] + (in != out);
+          turns[j][out] = std::min(turns[j][out], t);
+        }
+      }
+    }
+  }
+
+  // any cell the search didn't reach is in a piece of the maze cut off from the start. Count those pieces too
+  unsigned int pieces = 1;
+  for (uint16_t i = 0; i < SIZE * SIZE; i++) {
+    if (distance[i] != UNREACHED) {
+      continue;
+    }
+    pieces++;
+    distance[i] = 0;
+    frontier.push_back(i);
+    while (!frontier.empty()) {
+      const uint16_t k = frontier.pop_front();
+      const unsigned int r = k / SIZE;
+      const unsigned int c = k % SIZE;
+      for (Direction d = Direction::First; d < Direction::Last; d++) {
+        const uint16_t j = neighbor(k, d);
+        if (!walls.is_wall(r, c, d) && distance[j] == UNREACHED) {
+          distance[j] = 0;
+          frontier.push_back(j);
+        }
+      }
+    }
+  }
+  features.loops = open_walls + pieces - SIZE * SIZE;
+
+  // the nearest center cells are the ends of the shortest routes, and none of those routes go through another one
+  const unsigned int corner = smartmouse::maze::CENTER_CORNER;
+  uint16_t nearest = UNREACHED;
+  for (unsigned int r = corner; r < corner + smartmouse::maze::CENTER_CELLS; r++) {
+    for (unsigned int c = corner; c < corner + smartmouse::maze::CENTER_CELLS; c++) {
+      const uint16_t i = r * SIZE + c;
+      if (routes[i] == 0 || distance[i] > nearest) {
+        continue;
+      }
+      if (distance[i] < nearest) {
+        nearest = distance[i];
+        features.shortest_routes = 0;
+        features.route_turns = UNREACHED;
+      }
+      features.shortest_routes += routes[i];
+      features.route_turns = std::min<unsigned int>(features.route_turns, *std::min_element(turns[i], turns[i] + 4));
+    }
+  }
+  if (nearest == UNREACHED) {
+    features.route_turns = 0;
+  } else {
+    features.route_length = nearest;
+  }
+
+  return features;
+}
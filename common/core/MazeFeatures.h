@@ -0,0 +1,41 @@
+/** \brief numbers that describe what kind of maze a maze is, for sorting benchmark results by maze type
+ * and for checking that a corpus of random mazes looks like the mazes from real competitions.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "AbstractMaze.h"
+
+struct maze_features_t {
+  /** \brief cells with walls on three sides */
+  unsigned int dead_ends;
+
+  /** \brief the cyclomatic number, open walls - cells + pieces the maze is cut into.
+   * It's 0 for a perfect maze, and each wall knocked out of one after that adds a loop.
+   */
+  unsigned int loops;
+
+  /** \brief the most cells in a row, or in a column, with no walls between them */
+  unsigned int longest_straight;
+
+  /** \brief cells moved from the start to the nearest of the four center cells, or 0 if it can't be reached */
+  unsigned int route_length;
+
+  /** \brief the fewest turns on any of the shortest routes to the center */
+  unsigned int route_turns;
+
+  /** \brief how many different routes to the center are all the shortest */
+  uint64_t shortest_routes;
+};
+
+class MazeFeatures {
+public:
+  /** \brief work out every feature of the maze from the start at 0, 0, in time linear in the number of cells.
+   * One breadth first search finds the shortest route length, counts the shortest routes,
+   * and finds the fewest turns all at once, and the rest is counted straight off the walls.
+   */
+  static maze_features_t analyze(const MazeWalls &walls);
+
+  static maze_features_t analyze(const AbstractMaze &maze);
+};
@@ -0,0 +1,108 @@
+#include "MazeKnowledge.h"
+
+MazeKnowledge::MazeKnowledge() : route_cache(nullptr) {
+  reset();
+}
+
+void MazeKnowledge::reset() {
+  optimistic.remove_all_walls();
+  pessimistic.add_all_walls();
+  optimistic_hash = optimistic.zobrist_hash(OPTIMISTIC_PLANE);
+  pessimistic_hash = pessimistic.zobrist_hash(PESSIMISTIC_PLANE);
+  optimistic_fields.invalidate();
+  pessimistic_fields.invalidate();
+}
+
+void MazeKnowledge::update(SensorReading sr) {
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    if (sr.isWall(d)) {
+      mark_wall(sr.row, sr.col, d);
+    } else {
+      mark_open(sr.row, sr.col, d);
+    }
+  }
+}
+
+void MazeKnowledge::mark_wall(unsigned int row, unsigned int col, Direction dir) {
+  if (row >= smartmouse::maze::SIZE || col >= smartmouse::maze::SIZE) {
+    return;
+  }
+
+  // an unknown wall is already present in the pessimistic reading, so usually only the optimistic one changes.
+  // both change when a wall we thought was open turns out to be there
+  if (!optimistic.is_wall(row, col, dir)) {
+    optimistic.add_wall(row, col, dir);
+    optimistic_hash ^= MazeWalls::zobrist_key(row, col, dir, OPTIMISTIC_PLANE);
+    optimistic_fields.wall_added(optimistic, row, col, dir);
+  }
+  if (!pessimistic.is_wall(row, col, dir)) {
+    pessimistic.add_wall(row, col, dir);
+    pessimistic_hash ^= MazeWalls::zobrist_key(row, col, dir, PESSIMISTIC_PLANE);
+    pessimistic_fields.wall_added(pessimistic, row, col, dir);
+  }
+}
+
+void MazeKnowledge::mark_open(unsigned int row, unsigned int col, Direction dir) {
+  if (row >= smartmouse::maze::SIZE || col >= smartmouse::maze::SIZE) {
+    return;
+  }
+
+  // remove_wall won't knock down the perimeter, so only check for changes after trying
+  if (pessimistic.is_wall(row, col, dir)) {
+    pessimistic.remove_wall(row, col, dir);
+    if (!pessimistic.is_wall(row, col, dir)) {
+      pessimistic_hash ^= MazeWalls::zobrist_key(row, col, dir, PESSIMISTIC_PLANE);
+      pessimistic_fields.wall_removed(pessimistic, row, col, dir);
+    }
+  }
+  if (optimistic.is_wall(row, col, dir)) {
+    optimistic.remove_wall(row, col, dir);
+    if (!optimistic.is_wall(row, col, dir)) {
+      optimistic_hash ^= MazeWalls::zobrist_key(row, col, dir, OPTIMISTIC_PLANE);
+      optimistic_fields.wall_removed(optimistic, row, col, dir);
+    }
+  }
+}
+
+unsigned long MazeKnowledge::cells_updated() const {
+  return optimistic_fields.cells_updated + pessimistic_fields.cells_updated;
+}
+
+WallState MazeKnowledge::get_state(unsigned int row, unsigned int col, Direction dir) const {
+  if (optimistic.is_wall(row, col, dir)) {
+    return WallState::WALL;
+  } else if (!pessimistic.is_wall(row, col, dir)) {
+    return WallState::OPEN;
+  }
+  return WallState::UNKNOWN;
+}
+
+bool MazeKnowledge::optimistic_route(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1,
+                                     unsigned int c1, unsigned int goal_rows, unsigned int goal_cols) {
+  bool solvable;
+  if (route_cache != nullptr
+      && route_cache->lookup(optimistic_hash, r0, c0, r1, c1, goal_rows, goal_cols, path, &solvable)) {
+    return solvable;
+  }
+
+  solvable = optimistic_fields.get(optimistic, r1, c1, goal_rows, goal_cols).route(optimistic, path, r0, c0);
+  if (route_cache != nullptr) {
+    route_cache->store(optimistic_hash, r0, c0, r1, c1, goal_rows, goal_cols, *path, solvable);
+  }
+  return solvable;
+}
+
+bool MazeKnowledge::pessimistic_route(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1,
+                                      unsigned int c1, unsigned int goal_rows, unsigned int goal_cols) {
+  bool solvable;
+  if (route_cache != nullptr
+      && route_cache->lookup(pessimistic_hash, r0, c0, r1, c1, goal_rows, goal_cols, path, &solvable)) {
+    return solvable;
+  }
+
+  solvable = pessimistic_fields.get(pessimistic, r1, c1, goal_rows, goal_cols).route(pessimistic, path, r0, c0);
+  if (route_cache != nullptr) {
+    route_cache->store(pessimistic_hash, r0, c0, r1, c1, goal_rows, goal_cols, *path, solvable);
+  }
+  return solvable;
+}
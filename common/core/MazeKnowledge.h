@@ -0,0 +1,71 @@
+/** \brief what the mouse knows about the walls of the maze while it explores.
+ * Every wall is either unknown, open, or a wall. This is stored as the two ways of reading the unknown walls,
+ * one where they are all open and one where they are all present. A wall is known when both readings agree.
+ * Sensing a wall only changes the optimistic reading, and sensing an opening only changes the pessimistic one,
+ * so each sensed wall repairs just one set of distance fields.
+ */
+#pragma once
+
+#include "DistanceField.h"
+#include "MazeWalls.h"
+#include "Route.h"
+#include "RouteCache.h"
+#include "SensorReading.h"
+
+enum class WallState {
+  UNKNOWN,
+  OPEN,
+  WALL
+};
+
+class MazeKnowledge {
+public:
+  /** \brief which keys the hashes of each reading use, see MazeWalls::zobrist_key. AbstractMaze uses plane 0 */
+  static constexpr unsigned int OPTIMISTIC_PLANE = 1;
+  static constexpr unsigned int PESSIMISTIC_PLANE = 2;
+
+  /** \brief starts out knowing only the perimeter */
+  MazeKnowledge();
+
+  /** \brief forget everything except the perimeter */
+  void reset();
+
+  /** \brief learn all four walls around the cell of the reading */
+  void update(SensorReading sr);
+
+  void mark_wall(unsigned int row, unsigned int col, Direction dir);
+
+  void mark_open(unsigned int row, unsigned int col, Direction dir);
+
+  WallState get_state(unsigned int row, unsigned int col, Direction dir) const;
+
+  /** \brief shortest route from r0, c0 to the nearest cell of the goal at r1, c1, assuming every unknown wall is open.
+   * See DistanceField for how goals bigger than one cell work.
+   */
+  bool optimistic_route(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+                        unsigned int goal_rows = 1, unsigned int goal_cols = 1);
+
+  /** \brief shortest route from r0, c0 to the nearest cell of the goal at r1, c1, using only walls we know are open */
+  bool pessimistic_route(route_t *path, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+                         unsigned int goal_rows = 1, unsigned int goal_cols = 1);
+
+  /** \brief how many cells the distance fields of both readings have had to look at, see DistanceFieldCache */
+  unsigned long cells_updated() const;
+
+  /** \brief unknown walls are open. Change it with mark_wall and mark_open only */
+  MazeWalls optimistic;
+
+  /** \brief unknown walls are present. Change it with mark_wall and mark_open only */
+  MazeWalls pessimistic;
+
+  /** \brief Zobrist hashes of the two readings, kept up to date by mark_wall and mark_open */
+  uint64_t optimistic_hash;
+  uint64_t pessimistic_hash;
+
+  /** \brief when set, routes are reused as long as the reading they were planned in hasn't changed. Not owned */
+  RouteCache *route_cache;
+
+private:
+  DistanceFieldCache optimistic_fields;
+  DistanceFieldCache pessimistic_fields;
+};
@@ -0,0 +1,180 @@
+#ifndef ARDUINO
+
+#include "MazeParser.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string.h>
+
+namespace {
+
+constexpr uint8_t WALL = 0;
+constexpr uint8_t OPEN = 1;
+constexpr uint8_t INVALID = 2;
+
+/** \brief what each character means in the west and south spots of a cell, so a row is read without branching */
+struct wall_chars_t {
+  uint8_t west[256];
+  uint8_t south[256];
+};
+
+constexpr wall_chars_t make_wall_chars() {
+  wall_chars_t chars = {};
+  for (unsigned int i = 0; i < 256; i++) {
+    chars.west[i] = INVALID;
+    chars.south[i] = INVALID;
+  }
+  chars.west[static_cast<uint8_t>('|')] = WALL;
+  chars.west[static_cast<uint8_t>('_')] = OPEN;
+  chars.west[static_cast<uint8_t>(' ')] = OPEN;
+  chars.south[static_cast<uint8_t>('_')] = WALL;
+  chars.south[static_cast<uint8_t>(' ')] = OPEN;
+  return chars;
+}
+
+constexpr wall_chars_t WALL_CHARS = make_wall_chars();
+
+std::string describe(const std::string &file, unsigned int line, unsigned int column, const std::string &message) {
+  if (file.empty()) {
+    return "line " + std::to_string(line) + ", column " + std::to_string(column) + ": " + message;
+  }
+  return file + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message;
+}
+
+}
+
+MazeParseError::MazeParseError(const std::string &file, unsigned int line, unsigned int column,
+                               const std::string &message)
+    : std::runtime_error(describe(file, line, column, message)), file(file), line(line), column(column) {}
+
+MazeParser::MazeParser(const char *data, size_t length, const std::string &file)
+    : data(data), length(length), pos(0), line(0), file(file) {}
+
+bool MazeParser::next_line(const char **line, size_t *length) {
+  if (pos >= this->length) {
+    return false;
+  }
+
+  const char *start = data + pos;
+  const char *end = static_cast<const char *>(memchr(start, '\n', this->length - pos));
+  if (end == nullptr) {
+    end = data + this->length;
+  }
+
+  pos = (end - data) + 1;
+  this->line++;
+
+  *line = start;
+  *length = end - start;
+  if (*length > 0 && start[*length - 1] == '\r') {
+    (*length)--;
+  }
+  return true;
+}
+
+bool MazeParser::next(MazeWalls *walls) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+  // skip comments and blank lines until the first row
+  const char *row_line;
+  size_t row_length;
+  do {
+    if (!next_line(&row_line, &row_length)) {
+      return false;
+    }
+  } while (row_length == 0 || row_line[0] != '|');
+
+  for (unsigned int row = 0; row < SIZE; row++) {
+    if (row > 0 && !next_line(&row_line, &row_length)) {
+      throw MazeParseError(file, line + 1, 1, "the maze ends after " + std::to_string(row) + " of "
+                                              + std::to_string(SIZE) + " rows");
+    }
+    parse_row(row, row_line, row_length, walls);
+  }
+  return true;
+}
+
+void MazeParser::parse_row(unsigned int row, const char *row_line, size_t row_length, MazeWalls *walls) const {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+  if (row_length != 2 * SIZE + 1) {
+    throw_row_error(row, row_line, row_length);
+  }
+
+  // start with every wall in the row and knock down the open ones. Anything wrong is only noted here,
+  // and then throw_row_error goes back to find out what it was
+  unsigned int open_south = 0;
+  unsigned int open_west = 0;
+  unsigned int invalid = 0;
+  for (unsigned int col = 0; col < SIZE; col++) {
+    const uint8_t west = WALL_CHARS.west[static_cast<uint8_t>(row_line[2 * col])];
+    const uint8_t south = WALL_CHARS.south[static_cast<uint8_t>(row_line[2 * col + 1])];
+    invalid |= west | south;
+    open_west |= (west & OPEN) << col;
+    open_south |= (south & OPEN) << col;
+  }
+
+  // hand drawn mazes often leave a space before the '|' in the bottom right corner, it's still a wall
+  const bool open_perimeter = (open_west & 1u) || (row == SIZE - 1 && (open_south & ~MazeWalls::LAST_COL))
+                              || row_line[2 * SIZE] != '|';
+  if ((invalid & INVALID) || open_perimeter) {
+    throw_row_error(row, row_line, row_length);
+  }
+
+  // the west wall of a cell is the east wall of the one before it, and the perimeter bits are never cleared
+  walls->horizontal[row] = row == SIZE - 1 ? MazeWalls::FULL_ROW : MazeWalls::FULL_ROW & ~open_south;
+  walls->vertical[row] = MazeWalls::FULL_ROW & ~(open_west >> 1);
+}
+
+void MazeParser::throw_row_error(unsigned int row, const char *row_line, size_t row_length) const {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+  if (row_length != 2 * SIZE + 1) {
+    // a row of some other size of maze is the usual reason, so say what size it looks like
+    throw MazeParseError(file, line, std::min<size_t>(row_length, 2 * SIZE + 1) + 1,
+                         "expected a row of " + std::to_string(SIZE) + " cells, which is "
+                         + std::to_string(2 * SIZE + 1) + " characters, but this row has "
+                         + std::to_string(row_length));
+  }
+
+  for (unsigned int col = 0; col < SIZE; col++) {
+    const char west = row_line[2 * col];
+    const char south = row_line[2 * col + 1];
+
+    if (WALL_CHARS.west[static_cast<uint8_t>(west)] == INVALID) {
+      throw MazeParseError(file, line, 2 * col + 1, std::string("expected '|', '_', or ' ' for a west wall, not '")
+                                                   + west + "'");
+    }
+    if (col == 0 && west != '|') {
+      throw MazeParseError(file, line, 1, "the west side of the maze has to be a wall");
+    }
+    if (WALL_CHARS.south[static_cast<uint8_t>(south)] == INVALID) {
+      throw MazeParseError(file, line, 2 * col + 2, std::string("expected '_' or ' ' for a south wall, not '")
+                                                   + south + "'");
+    }
+    if (row == SIZE - 1 && south != '_' && col != SIZE - 1) {
+      throw MazeParseError(file, line, 2 * col + 2, "the south side of the maze has to be a wall");
+    }
+  }
+
+  throw MazeParseError(file, line, 2 * SIZE + 1, "the east side of the maze has to be a wall");
+}
+
+std::vector<MazeWalls> MazeParser::parse_file(const std::string &file) {
+  std::ifstream fs(file, std::ifstream::in | std::ifstream::binary);
+  if (!fs.good()) {
+    throw MazeParseError(file, 0, 0, "can't open the file");
+  }
+  const std::string contents((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+
+  std::vector<MazeWalls> mazes;
+  MazeParser parser(contents.data(), contents.size(), file);
+  MazeWalls walls;
+  while (parser.next(&walls)) {
+    mazes.push_back(walls);
+  }
+  return mazes;
+}
+
+#endif
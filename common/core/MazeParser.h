@@ -0,0 +1,69 @@
+/** \brief reads .mz text, one or many mazes at a time, straight out of a buffer.
+ * Each row of a maze is a line like "|_ _|_ ... |". For every cell there's a character for its west wall,
+ * which is a wall if it's '|' and open if it's '_' or ' ', then a character for its south wall,
+ * which is a wall if it's '_' and open if it's ' '. The line ends with the '|' of the east wall of the last cell.
+ * The north wall of the first row isn't written down, and the west, south, and east sides have to be walls.
+ * Lines that don't start with '|' are comments, like the "best answer so far" at the end of some files,
+ * so any number of mazes can be concatenated with or without comments between them.
+ * Both LF and CRLF line endings work.
+ */
+#pragma once
+
+#ifndef ARDUINO // there's no file system or exceptions on arduino
+
+#include <stddef.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "MazeWalls.h"
+
+/** \brief thrown for anything that isn't a closed SIZE x SIZE maze, with where in the file it went wrong */
+class MazeParseError : public std::runtime_error {
+public:
+  MazeParseError(const std::string &file, unsigned int line, unsigned int column, const std::string &message);
+
+  std::string file;
+
+  /** \brief both start at 1, like in an editor */
+  unsigned int line;
+  unsigned int column;
+};
+
+class MazeParser {
+public:
+  /** \brief the buffer isn't copied, so it has to outlive the parser
+   * \param file only used in error messages
+   */
+  MazeParser(const char *data, size_t length, const std::string &file = "");
+
+  /** \brief read the next maze, skipping any comments before it
+   * \return false if there are no more mazes
+   * \throws MazeParseError if the next maze is cut short or isn't valid
+   */
+  bool next(MazeWalls *walls);
+
+  /** \brief read every maze in a file
+   * \throws MazeParseError if the file can't be read, or any maze in it isn't valid
+   */
+  static std::vector<MazeWalls> parse_file(const std::string &file);
+
+private:
+  /** \brief the next line without its line ending, or false at the end of the buffer */
+  bool next_line(const char **line, size_t *length);
+
+  void parse_row(unsigned int row, const char *line, size_t length, MazeWalls *walls) const;
+
+  /** \brief only called once parse_row knows something is wrong with the row, to find out what and where */
+  [[noreturn]] void throw_row_error(unsigned int row, const char *line, size_t length) const;
+
+  const char *data;
+  size_t length;
+  size_t pos;
+
+  /** \brief number of the line next_line last returned */
+  unsigned int line;
+  std::string file;
+};
+
+#endif
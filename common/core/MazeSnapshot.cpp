@@ -0,0 +1,90 @@
+#include "MazeSnapshot.h"
+
+MazeSnapshot::MazeSnapshot(const MazeWalls &base) : base(&base) {
+  revert();
+}
+
+void MazeSnapshot::add_wall(unsigned int row, unsigned int col, Direction dir) {
+  set_wall(row, col, dir, true);
+}
+
+void MazeSnapshot::remove_wall(unsigned int row, unsigned int col, Direction dir) {
+  set_wall(row, col, dir, false);
+}
+
+void MazeSnapshot::set_wall(unsigned int row, unsigned int col, Direction dir, bool present) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+  // every wall is the south or east wall of some cell, and those on the perimeter never change
+  switch (dir) {
+    case Direction::N:
+      if (row == 0) return;
+      row--;
+      dir = Direction::S;
+      break;
+    case Direction::W:
+      if (col == 0) return;
+      col--;
+      dir = Direction::E;
+      break;
+    default:
+      break;
+  }
+
+  const unsigned int bit = 1u << col;
+  const bool differs = base->is_wall(row, col, dir) != present;
+  if (dir == Direction::S && row < SIZE - 1) {
+    horizontal[row] = differs ? horizontal[row] | bit : horizontal[row] & ~bit;
+  } else if (dir == Direction::E && col < SIZE - 1) {
+    vertical[row] = differs ? vertical[row] | bit : vertical[row] & ~bit;
+  }
+}
+
+void MazeSnapshot::revert() {
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    horizontal[r] = 0;
+    vertical[r] = 0;
+  }
+}
+
+unsigned int MazeSnapshot::changed_walls() const {
+  unsigned int count = 0;
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    count += __builtin_popcount(horizontal[r]) + __builtin_popcount(vertical[r]);
+  }
+  return count;
+}
+
+MazeWalls MazeSnapshot::walls() const {
+  MazeWalls walls = *base;
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    walls.horizontal[r] ^= horizontal[r];
+    walls.vertical[r] ^= vertical[r];
+  }
+  return walls;
+}
+
+void MazeSnapshot::repair(DistanceField *field) const {
+  // the field has to see the walls as they are after each change, so apply them one at a time
+  MazeWalls walls = *base;
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int bits = horizontal[r]; bits; bits &= bits - 1) {
+      const unsigned int c = __builtin_ctz(bits);
+      walls.horizontal[r] ^= 1u << c;
+      if (walls.is_wall(r, c, Direction::S)) {
+        field->wall_added(walls, r, c, Direction::S);
+      } else {
+        field->wall_removed(walls, r, c, Direction::S);
+      }
+    }
+    for (unsigned int bits = vertical[r]; bits; bits &= bits - 1) {
+      const unsigned int c = __builtin_ctz(bits);
+      walls.vertical[r] ^= 1u << c;
+      if (walls.is_wall(r, c, Direction::E)) {
+        field->wall_added(walls, r, c, Direction::E);
+      } else {
+        field->wall_removed(walls, r, c, Direction::E);
+      }
+    }
+  }
+}
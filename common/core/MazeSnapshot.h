@@ -0,0 +1,67 @@
+/** \brief a what-if copy of some walls, for trying out guesses about unknown walls without touching the real ones.
+ * The snapshot reads through to walls it doesn't own, and only keeps a bitboard of the walls it has changed,
+ * so making one clears 2 * SIZE words and dropping one is free however many are made from the same walls.
+ * Distance fields computed for the shared walls can be copied and repaired for just the changed walls,
+ * instead of flooding the whole maze once per guess.
+ */
+#pragma once
+
+#include "DistanceField.h"
+#include "MazeWalls.h"
+
+class MazeSnapshot {
+public:
+  /** \brief the base isn't copied, so it has to outlive the snapshot and not change while the snapshot is used */
+  explicit MazeSnapshot(const MazeWalls &base);
+
+  inline bool is_wall(unsigned int row, unsigned int col, const Direction dir) const {
+    return base->is_wall(row, col, dir) != changed(row, col, dir);
+  }
+
+  /** \brief like MazeWalls, walls on the perimeter are always present, so adding or removing them does nothing */
+  void add_wall(unsigned int row, unsigned int col, Direction dir);
+
+  void remove_wall(unsigned int row, unsigned int col, Direction dir);
+
+  /** \brief go back to being the same as the base */
+  void revert();
+
+  /** \return how many walls are different from the base */
+  unsigned int changed_walls() const;
+
+  /** \brief the base with the changes applied, for anything that needs a whole MazeWalls */
+  MazeWalls walls() const;
+
+  /** \brief repair a field that was computed or repaired for the base, so it's right for the snapshot.
+   * Each changed wall is handed to DistanceField::wall_added or wall_removed in turn,
+   * so it costs as much as those repairs do, and nothing when the snapshot hasn't changed anything.
+   */
+  void repair(DistanceField *field) const;
+
+  const MazeWalls *base;
+
+  /** \brief bit c of horizontal[r] is set when the south wall of (r, c) is different from the base,
+   * and likewise for vertical and the east wall
+   */
+  MazeWalls::row_bits_t horizontal[smartmouse::maze::SIZE];
+  MazeWalls::row_bits_t vertical[smartmouse::maze::SIZE];
+
+private:
+  inline bool changed(unsigned int row, unsigned int col, const Direction dir) const {
+    switch (dir) {
+      case Direction::N:
+        return row > 0 && ((horizontal[row - 1] >> col) & 1u);
+      case Direction::E:
+        return (vertical[row] >> col) & 1u;
+      case Direction::S:
+        return (horizontal[row] >> col) & 1u;
+      case Direction::W:
+        return col > 0 && ((vertical[row] >> (col - 1)) & 1u);
+      default:
+        return false;
+    }
+  }
+
+  /** \brief make the wall present or not, marking it changed only if that's different from the base */
+  void set_wall(unsigned int row, unsigned int col, Direction dir, bool present);
+};
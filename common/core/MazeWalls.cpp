@@ -0,0 +1,86 @@
+#include "MazeWalls.h"
+
+MazeWalls::MazeWalls() {
+  add_all_walls();
+}
+
+void MazeWalls::add_all_walls() {
+  unsigned int i;
+  for (i = 0; i < smartmouse::maze::SIZE; i++) {
+    horizontal[i] = FULL_ROW;
+    vertical[i] = FULL_ROW;
+  }
+}
+
+void MazeWalls::remove_all_walls() {
+  unsigned int i;
+  for (i = 0; i < smartmouse::maze::SIZE; i++) {
+    horizontal[i] = 0;
+    vertical[i] = LAST_COL;
+  }
+  horizontal[smartmouse::maze::SIZE - 1] = FULL_ROW;
+}
+
+uint64_t MazeWalls::zobrist_hash(unsigned int plane) const {
+  // only visit the walls that are there, since it's the keys that take the time
+  uint64_t hash = 0;
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int bits = horizontal[r]; bits; bits &= bits - 1) {
+      hash ^= zobrist_key(r, __builtin_ctz(bits), Direction::S, plane);
+    }
+    for (unsigned int bits = vertical[r]; bits; bits &= bits - 1) {
+      hash ^= zobrist_key(r, __builtin_ctz(bits), Direction::E, plane);
+    }
+  }
+  return hash;
+}
+
+namespace {
+
+/** \brief bit c of rows[r] becomes bit r of rows[c], by swapping the off diagonal halves, then quarters, and so on.
+ * Any maze fits in the top left corner, and the rest is zeros which stay in the bottom right.
+ */
+void transpose_bits(uint32_t rows[32]) {
+  uint32_t mask = 0x0000FFFFu;
+  for (unsigned int half = 16; half != 0; half >>= 1, mask ^= mask << half) {
+    for (unsigned int k = 0; k < 32; k = ((k | half) + 1) & ~half) {
+      const uint32_t swap = ((rows[k] >> half) ^ rows[k | half]) & mask;
+      rows[k] ^= swap << half;
+      rows[k | half] ^= swap;
+    }
+  }
+}
+
+}
+
+MazeWalls MazeWalls::transposed() const {
+  // the east walls of column c become the south walls of row c, and the other way around
+  uint32_t east[32] = {};
+  uint32_t south[32] = {};
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    east[r] = vertical[r];
+    south[r] = horizontal[r];
+  }
+  transpose_bits(east);
+  transpose_bits(south);
+
+  MazeWalls t;
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    t.horizontal[r] = east[r];
+    t.vertical[r] = south[r];
+  }
+  return t;
+}
+
+MazeWalls MazeWalls::canonical(bool *was_transposed) const {
+  const MazeWalls t = transposed();
+  const bool pick_transposed = memcmp(&t, this, sizeof(MazeWalls)) < 0;
+  if (was_transposed != nullptr) {
+    *was_transposed = pick_transposed;
+  }
+  return pick_transposed ? t : *this;
+}
+
+uint64_t MazeWalls::fingerprint() const {
+  return canonical().zobrist_hash();
+}
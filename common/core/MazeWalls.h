@@ -0,0 +1,198 @@
+/** \brief the dimensions of the maze, and the walls of a maze packed into bits
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "Direction.h"
+
+namespace smartmouse {
+namespace maze {
+
+// set by MAZE_SIZE in cmake, so each size is its own build and every loop over the maze has constant bounds
+#ifndef SMARTMOUSE_MAZE_SIZE
+#define SMARTMOUSE_MAZE_SIZE 16
+#endif
+
+constexpr static unsigned int SIZE = SMARTMOUSE_MAZE_SIZE;
+// the goal is the 2x2 square in the middle, which only has a middle when the size is even
+static_assert(SIZE >= 4 && SIZE <= 32 && SIZE % 2 == 0, "the maze must be an even size between 4x4 and 32x32");
+const unsigned long BUFF_SIZE = (SIZE * 2 + 3) * SIZE;
+constexpr static unsigned int CENTER = SIZE / 2;
+// the goal is the 2x2 square of cells in the middle, CENTER_CORNER is the row and column of its top left cell
+constexpr static unsigned int CENTER_CORNER = CENTER - 1;
+constexpr static unsigned int CENTER_CELLS = 2;
+
+/** \brief how much the index row * SIZE + col changes moving one cell in d */
+constexpr int index_delta(Direction d) {
+  return dir_row_delta(d) * static_cast<int>(SIZE) + dir_col_delta(d);
+}
+constexpr static double UNIT_DIST_M = 0.18;
+constexpr static double WALL_THICKNESS_M = 0.012;
+constexpr static double HALF_WALL_THICKNESS_M = WALL_THICKNESS_M / 2.0;
+constexpr static double HALF_UNIT_DIST = UNIT_DIST_M / 2.0;
+constexpr static double SIZE_M = SIZE * UNIT_DIST_M;
+
+constexpr double toMeters(double cu) {
+  return cu * UNIT_DIST_M;
+}
+
+constexpr double toCellUnits(double meters) {
+  return meters / UNIT_DIST_M;
+}
+
+constexpr double WALL_THICKNESS_CU = toCellUnits(WALL_THICKNESS_M);
+constexpr double HALF_WALL_THICKNESS_CU = toCellUnits(HALF_WALL_THICKNESS_M);
+constexpr double SIZE_CU = toCellUnits(SIZE_M);
+
+}
+}
+
+/**
+ * \brief the walls of a maze packed into two bit-planes, one word per row.
+ * bit c of horizontal[r] is the wall on the south side of (r, c), and
+ * bit c of vertical[r] is the wall on the east side of (r, c).
+ * The north walls of row 0 and west walls of col 0 are implied by the perimeter.
+ * The south walls of the last row and east walls of the last col are always set,
+ * so two MazeWalls with the same walls are always bitwise identical.
+ */
+class MazeWalls {
+ public:
+  /** \brief the smallest word that holds a row, so a 16x16 maze is still 64 bytes */
+  typedef typename std::conditional<smartmouse::maze::SIZE <= 8, uint8_t,
+      typename std::conditional<smartmouse::maze::SIZE <= 16, uint16_t, uint32_t>::type>::type row_bits_t;
+
+  static constexpr unsigned int FULL_ROW = 0xFFFFFFFFu >> (32 - smartmouse::maze::SIZE);
+  static constexpr unsigned int LAST_COL = 1u << (smartmouse::maze::SIZE - 1);
+
+  /** \brief starts with every wall present */
+  MazeWalls();
+
+  /** \brief put up every wall */
+  void add_all_walls();
+
+  /** \brief knock down every wall except the perimeter */
+  void remove_all_walls();
+
+  inline bool is_wall(unsigned int row, unsigned int col, const Direction dir) const {
+    switch (dir) {
+      case Direction::N:
+        return row == 0 || ((horizontal[row - 1] >> col) & 1u);
+      case Direction::E:
+        return (vertical[row] >> col) & 1u;
+      case Direction::S:
+        return (horizontal[row] >> col) & 1u;
+      case Direction::W:
+        return col == 0 || ((vertical[row] >> (col - 1)) & 1u);
+      default:
+        return true;
+    }
+  }
+
+  /** \brief walls on the perimeter are always present, so adding them does nothing */
+  inline void add_wall(unsigned int row, unsigned int col, const Direction dir) {
+    switch (dir) {
+      case Direction::N:
+        if (row > 0) horizontal[row - 1] |= (1u << col);
+        break;
+      case Direction::E:
+        vertical[row] |= (1u << col);
+        break;
+      case Direction::S:
+        horizontal[row] |= (1u << col);
+        break;
+      case Direction::W:
+        if (col > 0) vertical[row] |= (1u << (col - 1));
+        break;
+      default:
+        break;
+    }
+  }
+
+  /** \brief walls on the perimeter can't be removed, so removing them does nothing */
+  inline void remove_wall(unsigned int row, unsigned int col, const Direction dir) {
+    switch (dir) {
+      case Direction::N:
+        if (row > 0) horizontal[row - 1] &= ~(1u << col);
+        break;
+      case Direction::E:
+        if (col < smartmouse::maze::SIZE - 1) vertical[row] &= ~(1u << col);
+        break;
+      case Direction::S:
+        if (row < smartmouse::maze::SIZE - 1) horizontal[row] &= ~(1u << col);
+        break;
+      case Direction::W:
+        if (col > 0) vertical[row] &= ~(1u << (col - 1));
+        break;
+      default:
+        break;
+    }
+  }
+
+  /** \brief a random looking 64 bit key for one wall, for Zobrist hashing.
+   * The hash of a MazeWalls is the XOR of the keys of every wall that's present,
+   * so adding or removing a wall just XORs its key into the hash.
+   * Each plane is a different set of keys, so hashes of different kinds of walls never get mixed up.
+   * The implied walls north of row 0 and west of col 0 have a key of 0.
+   */
+  static inline uint64_t zobrist_key(unsigned int row, unsigned int col, const Direction dir, unsigned int plane = 0) {
+    constexpr unsigned int CELLS = smartmouse::maze::SIZE * smartmouse::maze::SIZE;
+    uint64_t z;
+    switch (dir) {
+      case Direction::N:
+        if (row == 0) return 0;
+        z = (row - 1) * smartmouse::maze::SIZE + col;
+        break;
+      case Direction::E:
+        z = CELLS + row * smartmouse::maze::SIZE + col;
+        break;
+      case Direction::S:
+        z = row * smartmouse::maze::SIZE + col;
+        break;
+      case Direction::W:
+        if (col == 0) return 0;
+        z = CELLS + row * smartmouse::maze::SIZE + col - 1;
+        break;
+      default:
+        return 0;
+    }
+
+    // splitmix64 of the wall's index
+    z = (z + 1 + plane * 2 * CELLS) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /** \brief hash every wall from scratch, see zobrist_key */
+  uint64_t zobrist_hash(unsigned int plane = 0) const;
+
+  /** \brief the maze mirrored across the diagonal through the start and the center, so (r, c) becomes (c, r),
+   * north swaps with west, and south swaps with east. Of the eight ways to rotate or flip the maze,
+   * this and doing nothing are the only two that keep the start in the corner and the goal in the middle.
+   */
+  MazeWalls transposed() const;
+
+  /** \brief whichever of these walls and transposed() comes first, so a maze and its mirror image have the same one
+   * \param was_transposed set to whether the transposed walls were picked, if it isn't null
+   */
+  MazeWalls canonical(bool *was_transposed = nullptr) const;
+
+  /** \brief the same for a maze and its mirror image, and different for anything else unless they collide.
+   * It's the Zobrist hash of canonical(), so it's the same as AbstractMaze::hash when the maze is canonical.
+   */
+  uint64_t fingerprint() const;
+
+  inline bool operator==(const MazeWalls &other) const {
+    return memcmp(this, &other, sizeof(MazeWalls)) == 0;
+  }
+
+  inline bool operator!=(const MazeWalls &other) const {
+    return !(*this == other);
+  }
+
+  row_bits_t horizontal[smartmouse::maze::SIZE];
+  row_bits_t vertical[smartmouse::maze::SIZE];
+};
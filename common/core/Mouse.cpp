@@ -31,7 +31,8 @@ Direction Mouse::getDir() {
 }
 
 bool Mouse::atCenter() {
-  return row == smartmouse::maze::CENTER && col == smartmouse::maze::CENTER;
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  return row - C < smartmouse::maze::CENTER_CELLS && col - C < smartmouse::maze::CENTER_CELLS;
 }
 
 bool Mouse::inBounds() {
@@ -45,34 +46,17 @@ void Mouse::internalTurnToFace(Direction dir) {
 }
 
 void Mouse::internalForward() {
-  switch (dir) {
-    case Direction::N:
-      row--;
-      break;
-    case Direction::E:
-      col++;
-      break;
-    case Direction::S:
-      row++;
-      break;
-    case Direction::W:
-      col--;
-      break;
-    default:
-      break;
-  }
+  row += dir_row_delta(dir);
+  col += dir_col_delta(dir);
 }
 
 bool Mouse::isWallInDirection(Direction d) {
-  Node *mouse_node;
-  maze->get_node(&mouse_node, row, col);
-  bool is_wall = mouse_node->neighbor(d) == nullptr;
-  return is_wall;
+  return maze->walls.is_wall(row, col, d);
 }
 
 
 void Mouse::mark_mouse_position_visited() {
-  maze->nodes[row][col]->visited = true;
+  maze->node(row, col).visited = true;
 }
 
 void Mouse::print_maze_mouse() {
@@ -86,41 +70,39 @@ void Mouse::maze_mouse_string(char *buff) {
   unsigned int i, j;
   for (i = 0; i < smartmouse::maze::SIZE; i++) {
     for (j = 0; j < smartmouse::maze::SIZE; j++) {
-      Node *n = maze->nodes[i][j];
-      if (n->neighbor(Direction::W) == NULL) {
-        strcpy(b++, "|");
+      if (maze->walls.is_wall(i, j, Direction::W)) {
+        *(b++) = '|';
       } else {
-        strcpy(b++, "_");
+        *(b++) = '_';
       }
 
       if (row == i && col == j) {
         switch(dir) {
           case Direction::N:
-            strcpy(b++, "^");
+            *(b++) = '^';
             break;
           case Direction::S:
-            strcpy(b++, "v");
+            *(b++) = 'v';
             break;
           case Direction::E:
-            strcpy(b++, ">");
+            *(b++) = '>';
             break;
           case Direction::W:
-            strcpy(b++, "<");
+            *(b++) = '<';
             break;
           default:
-            strcpy(b++, "o");
+            *(b++) = 'o';
             break;
         }
-      } else if (n->neighbor(Direction::S) == NULL) {
-        strcpy(b++, "_");
+      } else if (maze->walls.is_wall(i, j, Direction::S)) {
+        *(b++) = '_';
       } else {
-        strcpy(b++, " ");
+        *(b++) = ' ';
       }
     }
     *(b++) = '|';
     *(b++) = '\n';
   }
-  b++;
   *b = '\0';
 }
 
@@ -1,39 +1,20 @@
 #include "Node.h"
+#include "MazeWalls.h"
 
 const int Node::OUT_OF_BOUNDS = -2;
 
-Node *Node::neighbor(const Direction dir) {
-  switch (dir) {
-    case Direction::N:
-      return neighbors[0];
-    case Direction::E:
-      return neighbors[1];
-    case Direction::S:
-      return neighbors[2];
-    case Direction::W:
-      return neighbors[3];
-    default:
-      return 0;
-  }
-}
-
-Node::Node() : weight(32767), distance(0), known(false), visited(false), neighbors({}) {
+Node::Node() : weight(32767), known(false), visited(false), walls(0xF) {
 }
 
-Node::Node(unsigned int row, unsigned int col) : weight(-1), distance(0), known(false), visited(false), neighbors({}),
-                                                 r(row),
-                                                 c(col) {
-}
-
-unsigned int Node::row() {
-  return r;
-}
+Node *Node::neighbor(const Direction dir) {
+  // wall() is true for anything that isn't N, E, S, or W
+  if (wall(dir)) {
+    return nullptr;
+  }
 
-unsigned int Node::col() {
-  return c;
+  return this + smartmouse::maze::index_delta(dir);
 }
 
-
 void Node::assign_weights_to_neighbors(Node *goal, int weight, bool *success) {
   //check all nodes that are unvisited, or would be given a lower weight
   if (!this->known || weight < this->weight) {
@@ -48,16 +29,24 @@ void Node::assign_weights_to_neighbors(Node *goal, int weight, bool *success) {
     //update weight
     this->weight = weight;
 
-    //recursive call to explore each neighbors
-    int i;
-    for (i = 0; i < 4; i++) {
-      if (this->neighbors[i] != 0) {
-        this->neighbors[i]->assign_weights_to_neighbors(goal, weight + 1, success);
-      }
+    //recursive call to explore each neighbors, the nodes of a maze are contiguous so no lookup is needed
+    if (!wall(Direction::N)) {
+      (this - smartmouse::maze::SIZE)->assign_weights_to_neighbors(goal, weight + 1, success);
+    }
+    if (!wall(Direction::E)) {
+      (this + 1)->assign_weights_to_neighbors(goal, weight + 1, success);
+    }
+    if (!wall(Direction::S)) {
+      (this + smartmouse::maze::SIZE)->assign_weights_to_neighbors(goal, weight + 1, success);
+    }
+    if (!wall(Direction::W)) {
+      (this - 1)->assign_weights_to_neighbors(goal, weight + 1, success);
     }
   }
 }
 
-bool Node::wall(const Direction dir) {
-  return neighbor(dir) == nullptr;
+bool Node::wall(const Direction dir) const {
+  // anything that isn't N, E, S, or W is treated as a wall
+  const unsigned int d = static_cast<unsigned int>(dir);
+  return d >= 4 || ((walls >> d) & 1u);
 }
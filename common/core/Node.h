@@ -1,44 +1,39 @@
 #pragma once
 
-#include <array>
+#include <stdint.h>
+
 #include "common/core/Direction.h"
 
 /**
- * \brief holds its location & neighbors, as well as a bool for indicating if it has been discovered
- * you don't need to free nodes in a maze, just use free_maze however, be sure to free nodes allocated not in mazes
- * I finally gave in an added row and col attributes the node....be very careful you dont get fuck with those.
- * Don't ever move a node around in maze because you risk getting the actual row/col off from the nodes row/col
+ * \brief holds the search state of one cell, and which sides of it have walls.
+ * Nodes live next to each other in their maze, row after row, so a neighbor is found by stepping the pointer.
+ * There's no pointer back to the maze, so copying a maze is just copying its bytes.
+ * The walls here are a copy of the maze's MazeWalls for this cell, AbstractMaze keeps them in sync.
  * visited is meant for ACTUALLY visiting, known is just used for searching/solving
  */
 class Node {
 public:
-  int weight; //used for flood-fill
-  int distance; //used for a star
-  bool known;
-  bool visited;
-
-  //if you want to iterate over neighbors, just increment the pointer to north
-  std::array<Node *, 4> neighbors;
+  int16_t weight; //used for flood-fill
+  bool known : 1;
+  bool visited : 1;
 
   static const int OUT_OF_BOUNDS;
 
-  /** \brief intializes a node */
-  Node(unsigned int row, unsigned int col);
-
+  /** \brief intializes a node that isn't part of any maze, so it has walls on every side */
   Node();
 
-  unsigned int row();
-
-  unsigned int col();
-
-  /** \brief get the neighbor in the given direction */
+  /** \brief get the neighbor in the given direction, or null if there's a wall */
   Node *neighbor(const Direction dir);
 
-  bool wall(const Direction dir);
+  bool wall(const Direction dir) const;
 
   void assign_weights_to_neighbors(Node *goal, int weight, bool *success);
 
 private:
-  unsigned int r;
-  unsigned int c;
+  friend class AbstractMaze;
+
+  /** \brief one bit per Direction, set where there's a wall */
+  uint8_t walls : 4;
 };
+
+static_assert(sizeof(Node) <= 4, "nodes should stay small enough that copying a maze is cheap");
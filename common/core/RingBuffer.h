@@ -0,0 +1,159 @@
+#pragma once
+
+#include <stddef.h>
+#include <initializer_list>
+
+/** \brief the smallest power of two that's at least n, for picking a RingBuffer capacity */
+constexpr size_t round_up_to_power_of_two(size_t n) {
+  size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
+/**
+ * \brief fixed capacity circular buffer that never touches the heap.
+ * N must be a power of two so that wrapping around is just a mask.
+ * Pushing onto a full buffer or popping from an empty one is the caller's problem,
+ * check full() and empty() first.
+ */
+template<typename T, size_t N>
+class RingBuffer {
+  static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+  /** \brief walks from front to back, so range based for loops work */
+  template<typename B, typename V>
+  class basic_iterator {
+  public:
+    basic_iterator(B *buffer, size_t i) : buffer(buffer), i(i) {}
+
+    inline V &operator*() const {
+      return (*buffer)[i];
+    }
+
+    inline V *operator->() const {
+      return &(*buffer)[i];
+    }
+
+    inline basic_iterator &operator++() {
+      i++;
+      return *this;
+    }
+
+    inline bool operator==(const basic_iterator &other) const {
+      return i == other.i;
+    }
+
+    inline bool operator!=(const basic_iterator &other) const {
+      return i != other.i;
+    }
+
+  private:
+    B *buffer;
+    size_t i;
+  };
+
+public:
+  typedef basic_iterator<RingBuffer, T> iterator;
+  typedef basic_iterator<const RingBuffer, const T> const_iterator;
+
+  RingBuffer() : head(0), count(0) {}
+
+  RingBuffer(std::initializer_list<T> init) : head(0), count(0) {
+    for (const T &t : init) {
+      push_back(t);
+    }
+  }
+
+  inline void push_back(const T &t) {
+    items[(head + count) & MASK] = t;
+    count++;
+  }
+
+  inline void push_front(const T &t) {
+    head = (head - 1) & MASK;
+    items[head] = t;
+    count++;
+  }
+
+  inline T pop_front() {
+    T t = items[head];
+    head = (head + 1) & MASK;
+    count--;
+    return t;
+  }
+
+  inline T pop_back() {
+    count--;
+    return items[(head + count) & MASK];
+  }
+
+  inline T &front() {
+    return items[head];
+  }
+
+  inline T &back() {
+    return items[(head + count - 1) & MASK];
+  }
+
+  inline const T &front() const {
+    return items[head];
+  }
+
+  inline const T &back() const {
+    return items[(head + count - 1) & MASK];
+  }
+
+  inline iterator begin() {
+    return iterator(this, 0);
+  }
+
+  inline iterator end() {
+    return iterator(this, count);
+  }
+
+  inline const_iterator begin() const {
+    return const_iterator(this, 0);
+  }
+
+  inline const_iterator end() const {
+    return const_iterator(this, count);
+  }
+
+  inline T &operator[](size_t i) {
+    return items[(head + i) & MASK];
+  }
+
+  inline const T &operator[](size_t i) const {
+    return items[(head + i) & MASK];
+  }
+
+  inline void clear() {
+    head = 0;
+    count = 0;
+  }
+
+  inline bool empty() const {
+    return count == 0;
+  }
+
+  inline bool full() const {
+    return count == N;
+  }
+
+  inline size_t size() const {
+    return count;
+  }
+
+  static constexpr size_t capacity() {
+    return N;
+  }
+
+private:
+  static constexpr size_t MASK = N - 1;
+
+  T items[N];
+  size_t head;
+  size_t count;
+};
@@ -0,0 +1,34 @@
+#include "Route.h"
+
+#include <sstream>
+
+std::string route_to_string(const route_t &route) {
+  std::stringstream ss;
+  if (route.empty()) {
+    ss << "empty";
+  }
+
+  for (const motion_primitive_t &prim : route) {
+    ss << (int)prim.n << dir_to_char(prim.d);
+  }
+
+  return ss.str();
+}
+
+void insert_motion_primitive_back(route_t *route, motion_primitive_t prim) {
+  if (!route->empty() && prim.d == route->back().d) {
+    route->back().n += prim.n;
+  }
+  else if (!route->full()) {
+    route->push_back(prim);
+  }
+}
+
+void insert_motion_primitive_front(route_t *route, motion_primitive_t prim) {
+  if (!route->empty() && prim.d == route->front().d) {
+    route->front().n += prim.n;
+  }
+  else if (!route->full()) {
+    route->push_front(prim);
+  }
+}
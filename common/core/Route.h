@@ -0,0 +1,34 @@
+/** \brief routes are lists of straight moves, stored without ever touching the heap
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "Direction.h"
+#include "MazeWalls.h"
+#include "RingBuffer.h"
+
+struct motion_primitive_t {
+  uint8_t n;
+  Direction d;
+};
+
+/**
+ * \brief a route can visit every cell at most once, so that many moves always fits.
+ * Adding a move to either end is O(1). Iterate with a range based for loop or [], there's no at().
+ */
+typedef RingBuffer<motion_primitive_t, round_up_to_power_of_two(smartmouse::maze::SIZE * smartmouse::maze::SIZE)>
+    route_t;
+
+std::string route_to_string(const route_t &route);
+
+/** \brief adds the move to the front, merging it with the first move if they're in the same direction.
+ * Moves that don't fit are dropped.
+ */
+void insert_motion_primitive_front(route_t *route, motion_primitive_t prim);
+
+/** \brief adds the move to the back, merging it with the last move if they're in the same direction.
+ * Moves that don't fit are dropped.
+ */
+void insert_motion_primitive_back(route_t *route, motion_primitive_t prim);
@@ -0,0 +1,54 @@
+#include "RouteCache.h"
+
+RouteCache::RouteCache() : hits(0), misses(0), clock(0) {
+  clear();
+}
+
+bool RouteCache::lookup(uint64_t hash, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+                        unsigned int goal_rows, unsigned int goal_cols, route_t *route, bool *solvable) {
+  for (entry_t &entry : entries) {
+    if (entry.valid && entry.hash == hash && entry.r0 == r0 && entry.c0 == c0 && entry.r1 == r1 && entry.c1 == c1
+        && entry.goal_rows == goal_rows && entry.goal_cols == goal_cols) {
+      entry.last_used = ++clock;
+      *route = entry.route;
+      *solvable = entry.solvable;
+      hits++;
+      return true;
+    }
+  }
+
+  misses++;
+  return false;
+}
+
+void RouteCache::store(uint64_t hash, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+                       unsigned int goal_rows, unsigned int goal_cols, const route_t &route, bool solvable) {
+  entry_t *oldest = &entries[0];
+  for (entry_t &entry : entries) {
+    if (!entry.valid) {
+      oldest = &entry;
+      break;
+    }
+    if (entry.last_used < oldest->last_used) {
+      oldest = &entry;
+    }
+  }
+
+  oldest->valid = true;
+  oldest->solvable = solvable;
+  oldest->hash = hash;
+  oldest->r0 = r0;
+  oldest->c0 = c0;
+  oldest->r1 = r1;
+  oldest->c1 = c1;
+  oldest->goal_rows = goal_rows;
+  oldest->goal_cols = goal_cols;
+  oldest->last_used = ++clock;
+  oldest->route = route;
+}
+
+void RouteCache::clear() {
+  for (entry_t &entry : entries) {
+    entry.valid = false;
+  }
+}
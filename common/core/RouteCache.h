@@ -0,0 +1,48 @@
+/** \brief remembers the last few routes that were planned, keyed by the Zobrist hash of the walls they were planned in.
+ * Goals are rectangles of cells like DistanceField's, given by their top left cell and their size.
+ * If the walls haven't changed since a route from the same start to the same goal was planned,
+ * the old route is still the answer and the search can be skipped.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "Route.h"
+
+class RouteCache {
+public:
+  /** \brief routes are big, so only keep enough for the handful of routes Flood asks for every step */
+  static constexpr unsigned int SLOTS = 4;
+
+  RouteCache();
+
+  /** \brief copy out the route planned from r0, c0 to the goal at r1, c1 in walls with the given hash, if we have it.
+   * Counts a hit or a miss.
+   * \return whether the route was found
+   */
+  bool lookup(uint64_t hash, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+              unsigned int goal_rows, unsigned int goal_cols, route_t *route, bool *solvable);
+
+  /** \brief remember a route, replacing whichever route was used least recently */
+  void store(uint64_t hash, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1,
+             unsigned int goal_rows, unsigned int goal_cols, const route_t &route, bool solvable);
+
+  /** \brief forget every route, but keep counting */
+  void clear();
+
+  unsigned long hits;
+  unsigned long misses;
+
+private:
+  struct entry_t {
+    bool valid;
+    bool solvable;
+    uint8_t r0, c0, r1, c1, goal_rows, goal_cols;
+    uint64_t hash;
+    unsigned long last_used;
+    route_t route;
+  };
+
+  entry_t entries[SLOTS];
+  unsigned long clock;
+};
@@ -12,6 +12,8 @@ public:
 
   Solver(Mouse *mouse);
 
+  virtual ~Solver() = default;
+
   virtual void setup() = 0;
 
   virtual motion_primitive_t planNextStep() = 0;
@@ -0,0 +1,164 @@
+#include "SolverRegistry.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include "AStar.h"
+#include "DStarLite.h"
+#include "Flood.h"
+#include "WallFollow.h"
+
+namespace {
+
+constexpr solver_param_t TIMED = {"timed", "1 picks the speed run route by predicted seconds, 0 by fewest cells", 1};
+
+const solver_entry_t SOLVERS[] = {
+    {"flood", "repairs a distance field to the goal after every wall it senses", {TIMED, {}},
+     [](Mouse *mouse, const double *params, const route_timing_t *timing) -> Solver * {
+       Flood *flood = new Flood(mouse);
+       flood->setRouteTiming(params[0] != 0 ? timing : nullptr);
+       return flood;
+     }},
+    {"wallfollow", "follows the left wall, which never reaches the center of a competition maze", {},
+     [](Mouse *mouse, const double *, const route_timing_t *) -> Solver * {
+       return new WallFollow(mouse);
+     }},
+    {"astar", "searches from the mouse to the goal every step",
+     {TIMED, {"weight", "how much the heuristic counts, over 1 looks at fewer cells but can find longer routes", 1}},
+     [](Mouse *mouse, const double *params, const route_timing_t *timing) -> Solver * {
+       AStar *astar = new AStar(mouse);
+       astar->setRouteTiming(params[0] != 0 ? timing : nullptr);
+       astar->setHeuristicWeight(params[1]);
+       return astar;
+     }},
+    {"dstarlite", "keeps a search from the goal between steps, and repairs it when a wall cuts it", {TIMED, {}},
+     [](Mouse *mouse, const double *params, const route_timing_t *timing) -> Solver * {
+       DStarLite *dstar = new DStarLite(mouse);
+       dstar->setRouteTiming(params[0] != 0 ? timing : nullptr);
+       return dstar;
+     }},
+};
+
+constexpr unsigned int COUNT = sizeof(SOLVERS) / sizeof(SOLVERS[0]);
+
+}
+
+unsigned int SolverRegistry::count() {
+  return COUNT;
+}
+
+const solver_entry_t &SolverRegistry::entry(unsigned int index) {
+  return SOLVERS[index];
+}
+
+bool SolverRegistry::choose(const char *name, solver_choice_t *choice) {
+  for (unsigned int i = 0; i < COUNT; i++) {
+    if (strcmp(SOLVERS[i].name, name) == 0) {
+      *choice = choose(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+solver_choice_t SolverRegistry::choose(unsigned int index) {
+  solver_choice_t choice;
+  choice.index = index;
+  for (unsigned int p = 0; p < solver_entry_t::MAX_PARAMS; p++) {
+    choice.params[p] = SOLVERS[index].params[p].default_value;
+  }
+  return choice;
+}
+
+bool SolverRegistry::set_param(solver_choice_t *choice, const char *assignment) {
+  const char *equals = strchr(assignment, '=');
+  if (equals == nullptr) {
+    return false;
+  }
+
+  const solver_param_t *params = SOLVERS[choice->index].params;
+  const size_t name_length = equals - assignment;
+  for (unsigned int p = 0; p < solver_entry_t::MAX_PARAMS && params[p].name; p++) {
+    if (strlen(params[p].name) == name_length && strncmp(params[p].name, assignment, name_length) == 0) {
+      char *end;
+      const double value = strtod(equals + 1, &end);
+      if (end == equals + 1 || *end != '\0') {
+        return false;
+      }
+      choice->params[p] = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string SolverRegistry::describe() {
+  std::stringstream ss;
+  for (const solver_entry_t &solver : SOLVERS) {
+    ss << "  " << solver.name << ": " << solver.description << "\n";
+    for (const solver_param_t &param : solver.params) {
+      if (param.name) {
+        ss << "    " << param.name << "=" << param.default_value << ": " << param.description << "\n";
+      }
+    }
+  }
+  return ss.str();
+}
+
+Solver *SolverRegistry::create(const solver_choice_t &choice, Mouse *mouse, const route_timing_t *timing) {
+  return SOLVERS[choice.index].create(mouse, choice.params, timing);
+}
+
+SelectedSolver::SelectedSolver(Mouse *mouse, const route_timing_t *timing)
+    : Solver(mouse), timing(timing), index(0),
+      solver(SolverRegistry::create(SolverRegistry::choose(0u), mouse, timing)) {}
+
+SelectedSolver::~SelectedSolver() {
+  delete solver;
+}
+
+void SelectedSolver::select(unsigned int index) {
+  if (index == this->index || index >= SolverRegistry::count()) {
+    return;
+  }
+  delete solver;
+  this->index = index;
+  solver = SolverRegistry::create(SolverRegistry::choose(index), mouse, timing);
+  setup();
+}
+
+unsigned int SelectedSolver::selected() const {
+  return index;
+}
+
+void SelectedSolver::setup() {
+  solver->setup();
+  solvable = solver->solvable;
+}
+
+motion_primitive_t SelectedSolver::planNextStep() {
+  const motion_primitive_t prim = solver->planNextStep();
+  solvable = solver->solvable;
+  return prim;
+}
+
+bool SelectedSolver::isFinished() {
+  const bool finished = solver->isFinished();
+  solvable = solver->solvable;
+  return finished;
+}
+
+route_t SelectedSolver::solve() {
+  const route_t route = solver->solve();
+  solvable = solver->solvable;
+  return route;
+}
+
+void SelectedSolver::teardown() {
+  solver->teardown();
+}
+
+void SelectedSolver::setGoal(Goal goal) {
+  solver->setGoal(goal);
+}
@@ -0,0 +1,102 @@
+/** \brief every solver by name, with the parameters each one takes, so programs can pick one when they run.
+ * Each solver has a small block of named numbers with defaults, which "name=value" strings can change.
+ * Solvers that pick a speed run route take the route timing separately, because it comes from the
+ * KinematicController and the core can't depend on that.
+ */
+#pragma once
+
+#include <string>
+
+#include "Mouse.h"
+#include "Solver.h"
+#include "TimedRoutePlanner.h"
+
+struct solver_param_t {
+  const char *name;
+  const char *description;
+  double default_value;
+};
+
+struct solver_entry_t {
+  static constexpr unsigned int MAX_PARAMS = 2;
+
+  const char *name;
+  const char *description;
+
+  /** \brief the ones after the last parameter have a null name */
+  solver_param_t params[MAX_PARAMS];
+
+  /** \brief make the solver with new. The timing can be null, and has to outlive the solver */
+  Solver *(*create)(Mouse *mouse, const double *params, const route_timing_t *timing);
+};
+
+/** \brief which solver to make, and the values of its parameters */
+struct solver_choice_t {
+  unsigned int index;
+  double params[solver_entry_t::MAX_PARAMS];
+};
+
+class SolverRegistry {
+public:
+  static unsigned int count();
+
+  static const solver_entry_t &entry(unsigned int index);
+
+  /** \brief pick the solver called name with its default parameters
+   * \return false if no solver has that name
+   */
+  static bool choose(const char *name, solver_choice_t *choice);
+
+  /** \brief pick the solver at index with its default parameters */
+  static solver_choice_t choose(unsigned int index);
+
+  /** \brief change one parameter of the chosen solver from a string like "weight=1.5"
+   * \return false if the solver has no such parameter, or the value isn't a number
+   */
+  static bool set_param(solver_choice_t *choice, const char *assignment);
+
+  /** \brief every solver and its parameters with their defaults, one per line, for usage messages */
+  static std::string describe();
+
+  /** \brief make the chosen solver with new, the caller owns it */
+  static Solver *create(const solver_choice_t &choice, Mouse *mouse, const route_timing_t *timing);
+};
+
+/**
+ * \brief forwards everything to whichever registered solver was selected last.
+ * Commands keep the Solver they were made with, so this lets the real mouse pick one from its menu
+ * after SolveCommand was already made. Selecting a different solver starts that one over with setup().
+ */
+class SelectedSolver : public Solver {
+public:
+  /** \brief starts with the first solver in the registry */
+  SelectedSolver(Mouse *mouse, const route_timing_t *timing);
+
+  ~SelectedSolver();
+
+  SelectedSolver(const SelectedSolver &) = delete;
+
+  SelectedSolver &operator=(const SelectedSolver &) = delete;
+
+  /** \brief switch to the solver at index with its default parameters, unless it's the one already running */
+  void select(unsigned int index);
+
+  unsigned int selected() const;
+
+  virtual void setup() override;
+
+  virtual motion_primitive_t planNextStep() override;
+
+  virtual bool isFinished() override;
+
+  virtual route_t solve() override;
+
+  virtual void teardown() override;
+
+  virtual void setGoal(Goal goal) override;
+
+private:
+  const route_timing_t *timing;
+  unsigned int index;
+  Solver *solver;
+};
@@ -0,0 +1,146 @@
+#include "TimedRoutePlanner.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "IndexedHeap.h"
+
+namespace {
+
+constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+
+// state (row * SIZE + col) * 4 + heading is turning in that cell to face heading.
+// The four after those are the start cell before the first run, which is the only time the mouse is stopped
+constexpr unsigned int TURN_STATES = SIZE * SIZE * 4;
+constexpr unsigned int STATES = TURN_STATES + 4;
+constexpr float INFINITE = std::numeric_limits<float>::infinity();
+
+typedef IndexedHeap<float, STATES> StateHeap;
+
+inline Direction heading_of(uint16_t s) {
+  return static_cast<Direction>(s % 4);
+}
+
+inline double turn_time(const route_timing_t &timing, Direction from, Direction to) {
+  if (!is_valid_dir(from) || from == to) {
+    return 0;
+  }
+  return to == opposite_direction(from) ? timing.turn_around : timing.turn;
+}
+
+}
+
+route_timing_t TimedRoutePlanner::cell_count_timing() {
+  route_timing_t timing;
+  for (unsigned int n = 1; n <= SIZE; n++) {
+    timing.run[0][0][n - 1] = timing.run[0][1][n - 1] = timing.run[1][0][n - 1] = timing.run[1][1][n - 1] = n;
+  }
+  timing.turn = 0;
+  timing.turn_around = 0;
+  return timing;
+}
+
+bool TimedRoutePlanner::plan(const route_timing_t &timing, const MazeWalls &walls, route_t *path, double *seconds,
+                             unsigned int row, unsigned int col, Direction facing, unsigned int goal_row,
+                             unsigned int goal_col, unsigned int goal_rows, unsigned int goal_cols) {
+  path->clear();
+  auto in_goal = [=](unsigned int r, unsigned int c) {
+    return r - goal_row < goal_rows && c - goal_col < goal_cols;
+  };
+  if (in_goal(row, col)) {
+    if (seconds) {
+      *seconds = 0;
+    }
+    return true;
+  }
+
+  float cost[STATES];
+  uint16_t parent[STATES];
+  uint8_t run_length[STATES];
+  std::fill(cost, cost + STATES, INFINITE);
+  StateHeap heap(cost);
+
+  // the mouse can face any way before its first run, but it has to turn to do it
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    const uint16_t s = TURN_STATES + static_cast<int>(d);
+    cost[s] = turn_time(timing, facing, d);
+    heap.push_or_lower(s);
+  }
+
+  float best = INFINITE;
+  uint16_t best_state = StateHeap::NOT_QUEUED;
+  uint8_t best_run = 0;
+  while (!heap.empty()) {
+    const uint16_t s = heap.pop();
+    // every route still queued is already slower than the best way into the goal
+    if (cost[s] >= best) {
+      break;
+    }
+
+    const bool start = s >= TURN_STATES;
+    const Direction h = heading_of(s);
+    const double (*runs)[SIZE] = timing.run[start ? 0 : 1];
+    unsigned int r = start ? row : s / 4 / SIZE;
+    unsigned int c = start ? col : s / 4 % SIZE;
+    for (unsigned int n = 1; !walls.is_wall(r, c, h); n++) {
+      r += dir_row_delta(h);
+      c += dir_col_delta(h);
+
+      if (in_goal(r, c) && cost[s] + runs[0][n - 1] < best) {
+        best = cost[s] + runs[0][n - 1];
+        best_state = s;
+        best_run = n;
+      }
+
+      const float turned = cost[s] + runs[1][n - 1] + timing.turn;
+      for (const Direction d : {left_of_dir(h), right_of_dir(h)}) {
+        const uint16_t next = (r * SIZE + c) * 4 + static_cast<int>(d);
+        if (!walls.is_wall(r, c, d) && turned < cost[next]) {
+          cost[next] = turned;
+          parent[next] = s;
+          run_length[next] = n;
+          heap.push_or_lower(next);
+        }
+      }
+    }
+  }
+
+  if (best_state == StateHeap::NOT_QUEUED) {
+    return false;
+  }
+
+  // each state was reached by a run in the heading of its parent
+  insert_motion_primitive_front(path, {best_run, heading_of(best_state)});
+  for (uint16_t s = best_state; s < TURN_STATES; s = parent[s]) {
+    insert_motion_primitive_front(path, {run_length[s], heading_of(parent[s])});
+  }
+  // the search adds up floats to save memory, so add the route up again properly
+  if (seconds) {
+    *seconds = time(timing, *path, facing);
+  }
+  return true;
+}
+
+double TimedRoutePlanner::time(const route_timing_t &timing, const route_t &path, Direction facing) {
+  // a route can say the same direction twice in a row, so merge those into one run first
+  route_t runs;
+  for (const motion_primitive_t &prim : path) {
+    if (prim.n > 0) {
+      insert_motion_primitive_back(&runs, prim);
+    }
+  }
+
+  double seconds = 0;
+  for (unsigned int i = 0; i < runs.size(); i++) {
+    const Direction d = runs[i].d;
+    const Direction from = i == 0 ? facing : runs[i - 1].d;
+    seconds += turn_time(timing, from, d);
+
+    // turning around stops first, and so does the last run
+    const bool after_turn = i > 0 && from != opposite_direction(d);
+    const bool before_turn = i + 1 < runs.size() && runs[i + 1].d != opposite_direction(d);
+    const unsigned int n = std::min<unsigned int>(runs[i].n, SIZE);
+    seconds += timing.run[after_turn][before_turn][n - 1];
+  }
+  return seconds;
+}
@@ -0,0 +1,47 @@
+/** \brief the fastest route by predicted seconds, instead of the fewest cells like flood fill.
+ * A route is straight runs with turns between them, and a long run is much faster per cell than a short one,
+ * so a route with fewer turns and longer straights can win even when it's a few cells longer.
+ * The seconds come from a route_timing_t. KinematicController fills one in from the same velocity profiles
+ * the mouse drives, which keeps the core from depending on the motion model.
+ */
+#pragma once
+
+#include "MazeWalls.h"
+#include "Route.h"
+
+struct route_timing_t {
+  /** \brief run[after_turn][before_turn][n - 1] is how many seconds a straight run of n cells takes.
+   * after_turn is 0 for the first run, which starts stopped in the middle of the start cell,
+   * and before_turn is 0 for the last run, which stops in the middle of a goal cell.
+   */
+  double run[2][2][smartmouse::maze::SIZE];
+
+  /** \brief seconds for a 90 degree turn between two runs */
+  double turn;
+
+  /** \brief seconds to turn around in place, which the fastest route only ever does before its first run */
+  double turn_around;
+};
+
+class TimedRoutePlanner {
+public:
+  /** \brief every cell takes a second and turning is free, so the fastest route is a shortest one */
+  static route_timing_t cell_count_timing();
+
+  /** \brief the fastest route from row, col to the goal, starting stopped and facing the given direction.
+   * This is Dijkstra's algorithm over (cell, heading) states, where each state is a cell the mouse turns in.
+   * The edges out of a state are every straight run from it that ends in a turn or in the goal,
+   * so the cells in the middle of a run are never states, and a run's time can depend on its whole length.
+   * \param seconds set to the predicted time of the route, if it isn't null
+   * \param goal_row, goal_col the top left cell of the goal
+   * \return false, with an empty path, if the goal can't be reached
+   */
+  static bool plan(const route_timing_t &timing, const MazeWalls &walls, route_t *path, double *seconds,
+                   unsigned int row, unsigned int col, Direction facing, unsigned int goal_row, unsigned int goal_col,
+                   unsigned int goal_rows = 1, unsigned int goal_cols = 1);
+
+  /** \brief the predicted seconds for driving a route, starting stopped and facing the given direction.
+   * A turn back the way the mouse came stops, turns around, and starts again.
+   */
+  static double time(const route_timing_t &timing, const route_t &path, Direction facing);
+};
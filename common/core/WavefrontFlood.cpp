@@ -0,0 +1,261 @@
+#include "WavefrontFlood.h"
+
+// the vector versions hold exactly 16 rows of 16 bits, other maze sizes use plain integers
+#if defined(__SSE2__) && SMARTMOUSE_MAZE_SIZE == 16
+#define WAVEFRONT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && SMARTMOUSE_MAZE_SIZE == 16
+#define WAVEFRONT_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+typedef MazeWalls::row_bits_t row_bits_t;
+
+/**
+ * A plane is one bit per cell of the maze, SIZE rows of SIZE bits.
+ * shift_east moves every bit one col east, shift_south moves every row one row south, and so on.
+ * Bits shifted off the edge of the maze are dropped.
+ */
+#if defined(WAVEFRONT_SSE2)
+
+struct Plane {
+  __m128i lo; // rows 0 to 7
+  __m128i hi; // rows 8 to 15
+};
+
+inline Plane load(const row_bits_t *rows) {
+  return {_mm_loadu_si128(reinterpret_cast<const __m128i *>(rows)),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows + 8))};
+}
+
+inline void store(row_bits_t *rows, Plane p) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(rows), p.lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(rows + 8), p.hi);
+}
+
+inline Plane operator&(Plane a, Plane b) {
+  return {_mm_and_si128(a.lo, b.lo), _mm_and_si128(a.hi, b.hi)};
+}
+
+inline Plane operator|(Plane a, Plane b) {
+  return {_mm_or_si128(a.lo, b.lo), _mm_or_si128(a.hi, b.hi)};
+}
+
+/** \brief a & ~b */
+inline Plane and_not(Plane a, Plane b) {
+  return {_mm_andnot_si128(b.lo, a.lo), _mm_andnot_si128(b.hi, a.hi)};
+}
+
+inline Plane shift_east(Plane p) {
+  return {_mm_slli_epi16(p.lo, 1), _mm_slli_epi16(p.hi, 1)};
+}
+
+inline Plane shift_west(Plane p) {
+  return {_mm_srli_epi16(p.lo, 1), _mm_srli_epi16(p.hi, 1)};
+}
+
+inline Plane shift_south(Plane p) {
+  return {_mm_slli_si128(p.lo, 2), _mm_or_si128(_mm_slli_si128(p.hi, 2), _mm_srli_si128(p.lo, 14))};
+}
+
+inline Plane shift_north(Plane p) {
+  return {_mm_or_si128(_mm_srli_si128(p.lo, 2), _mm_slli_si128(p.hi, 14)), _mm_srli_si128(p.hi, 2)};
+}
+
+inline bool empty(Plane p) {
+  __m128i any = _mm_or_si128(p.lo, p.hi);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) == 0xFFFF;
+}
+
+#elif defined(WAVEFRONT_NEON)
+
+struct Plane {
+  uint16x8_t lo; // rows 0 to 7
+  uint16x8_t hi; // rows 8 to 15
+};
+
+inline Plane load(const row_bits_t *rows) {
+  return {vld1q_u16(rows), vld1q_u16(rows + 8)};
+}
+
+inline void store(row_bits_t *rows, Plane p) {
+  vst1q_u16(rows, p.lo);
+  vst1q_u16(rows + 8, p.hi);
+}
+
+inline Plane operator&(Plane a, Plane b) {
+  return {vandq_u16(a.lo, b.lo), vandq_u16(a.hi, b.hi)};
+}
+
+inline Plane operator|(Plane a, Plane b) {
+  return {vorrq_u16(a.lo, b.lo), vorrq_u16(a.hi, b.hi)};
+}
+
+/** \brief a & ~b */
+inline Plane and_not(Plane a, Plane b) {
+  return {vbicq_u16(a.lo, b.lo), vbicq_u16(a.hi, b.hi)};
+}
+
+inline Plane shift_east(Plane p) {
+  return {vshlq_n_u16(p.lo, 1), vshlq_n_u16(p.hi, 1)};
+}
+
+inline Plane shift_west(Plane p) {
+  return {vshrq_n_u16(p.lo, 1), vshrq_n_u16(p.hi, 1)};
+}
+
+inline Plane shift_south(Plane p) {
+  return {vextq_u16(vdupq_n_u16(0), p.lo, 7), vextq_u16(p.lo, p.hi, 7)};
+}
+
+inline Plane shift_north(Plane p) {
+  return {vextq_u16(p.lo, p.hi, 1), vextq_u16(p.hi, vdupq_n_u16(0), 1)};
+}
+
+inline bool empty(Plane p) {
+  uint16x8_t any = vorrq_u16(p.lo, p.hi);
+  uint16x4_t half = vorr_u16(vget_low_u16(any), vget_high_u16(any));
+  return vget_lane_u64(vreinterpret_u64_u16(half), 0) == 0;
+}
+
+#else
+
+struct Plane {
+  row_bits_t rows[SIZE];
+};
+
+inline Plane load(const row_bits_t *rows) {
+  Plane p;
+  for (unsigned int r = 0; r < SIZE; r++) {
+    p.rows[r] = rows[r];
+  }
+  return p;
+}
+
+inline void store(row_bits_t *rows, Plane p) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    rows[r] = p.rows[r];
+  }
+}
+
+inline Plane operator&(Plane a, Plane b) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    a.rows[r] &= b.rows[r];
+  }
+  return a;
+}
+
+inline Plane operator|(Plane a, Plane b) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    a.rows[r] |= b.rows[r];
+  }
+  return a;
+}
+
+/** \brief a & ~b */
+inline Plane and_not(Plane a, Plane b) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    a.rows[r] &= ~b.rows[r];
+  }
+  return a;
+}
+
+inline Plane shift_east(Plane p) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    p.rows[r] = (p.rows[r] << 1) & MazeWalls::FULL_ROW;
+  }
+  return p;
+}
+
+inline Plane shift_west(Plane p) {
+  for (unsigned int r = 0; r < SIZE; r++) {
+    p.rows[r] >>= 1;
+  }
+  return p;
+}
+
+inline Plane shift_south(Plane p) {
+  for (unsigned int r = SIZE - 1; r > 0; r--) {
+    p.rows[r] = p.rows[r - 1];
+  }
+  p.rows[0] = 0;
+  return p;
+}
+
+inline Plane shift_north(Plane p) {
+  for (unsigned int r = 0; r < SIZE - 1; r++) {
+    p.rows[r] = p.rows[r + 1];
+  }
+  p.rows[SIZE - 1] = 0;
+  return p;
+}
+
+inline bool empty(Plane p) {
+  row_bits_t any = 0;
+  for (unsigned int r = 0; r < SIZE; r++) {
+    any |= p.rows[r];
+  }
+  return any == 0;
+}
+
+#endif
+
+}
+
+bool wavefront_assign_weights(AbstractMaze *maze, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1) {
+  // a bit is set where you can move east or south out of that cell
+  row_bits_t open_rows[SIZE];
+  for (unsigned int r = 0; r < SIZE; r++) {
+    open_rows[r] = ~maze->walls.vertical[r] & MazeWalls::FULL_ROW;
+  }
+  const Plane open_east = load(open_rows);
+  for (unsigned int r = 0; r < SIZE; r++) {
+    open_rows[r] = ~maze->walls.horizontal[r] & MazeWalls::FULL_ROW;
+  }
+  const Plane open_south = load(open_rows);
+
+  row_bits_t rows[SIZE] = {};
+  rows[r0] = 1u << c0;
+  Plane frontier = load(rows);
+  Plane reached = frontier;
+
+  maze->node(r0, c0).known = true;
+  maze->node(r0, c0).weight = 0;
+  if (r0 == r1 && c0 == c1) {
+    return true;
+  }
+
+  for (int weight = 1; ; weight++) {
+    // you can move west or north into a cell when it's open to the east or south
+    Plane next = shift_east(frontier & open_east)
+                 | (shift_west(frontier) & open_east)
+                 | shift_south(frontier & open_south)
+                 | (shift_north(frontier) & open_south);
+    frontier = and_not(next, reached);
+
+    if (empty(frontier)) {
+      return false;
+    }
+
+    reached = reached | frontier;
+
+    // every newly reached cell is this many steps from the start
+    store(rows, frontier);
+    for (unsigned int r = 0; r < SIZE; r++) {
+      unsigned int bits = rows[r];
+      while (bits) {
+        unsigned int c = __builtin_ctz(bits);
+        maze->node(r, c).known = true;
+        maze->node(r, c).weight = weight;
+        bits &= bits - 1;
+      }
+    }
+
+    if ((rows[r1] >> c1) & 1u) {
+      return true;
+    }
+  }
+}
@@ -0,0 +1,15 @@
+/** \brief flood fill that treats each row of the maze as a bitmask.
+ * Every step of the wavefront moves to all reachable neighbors at once with shifts and ANDs against the open walls,
+ * so the number of steps is the distance to the goal instead of the number of cells.
+ * Uses SSE2 or NEON when the compiler has them, and plain integers otherwise (like on the Cortex-M4).
+ */
+#pragma once
+
+#include "AbstractMaze.h"
+
+/** \brief sets the weight of each node to its distance from r0, c0, just like AbstractMaze::assign_weights.
+ * The flood stops after the step that reaches r1, c1, so nodes farther away than the goal may be left unknown.
+ * Call maze->reset() first.
+ * \return true if the goal was reached
+ */
+bool wavefront_assign_weights(AbstractMaze *maze, unsigned int r0, unsigned int c0, unsigned int r1, unsigned int c1);
@@ -12,18 +12,17 @@ ConsoleMouse *ConsoleMouse::inst() {
 
 void ConsoleMouse::seedMaze(AbstractMaze *maze) { this->true_maze = maze; }
 
-ConsoleMouse::ConsoleMouse() {}
+ConsoleMouse::ConsoleMouse() : live_renderer(nullptr) {}
 
 ConsoleMouse::ConsoleMouse(int starting_row, int starting_col)
-        : Mouse(starting_row, starting_col) {}
+        : Mouse(starting_row, starting_col), live_renderer(nullptr) {}
 
 SensorReading ConsoleMouse::checkWalls() {
   SensorReading sr(row, col);
   std::array<bool, 4> *w = &sr.walls;
-  Node *n = true_maze->nodes[row][col];
 
-  for (unsigned int i = 0; i < w->size(); i++) {
-    (*w)[i] = (n->neighbors[i] == 0x0);
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    (*w)[static_cast<int>(d)] = true_maze->walls.is_wall(row, col, d);
   }
 
   return sr;
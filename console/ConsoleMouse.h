@@ -3,6 +3,7 @@
 #include <common/core/Mouse.h>
 #include <common/core/SensorReading.h>
 #include <common/core/Pose.h>
+#include <console/MazeRenderer.h>
 
 class ConsoleMouse : public Mouse {
 public:
@@ -17,6 +18,9 @@ public:
 
   void seedMaze(AbstractMaze *maze);
 
+  /** \brief when set, every step is drawn with it instead of printing the maze and waiting for enter */
+  MazeRenderer *live_renderer;
+
 private:
 
   static ConsoleMouse *instance;
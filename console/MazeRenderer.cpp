@@ -0,0 +1,189 @@
+#include "MazeRenderer.h"
+
+#include <algorithm>
+#include <sstream>
+
+MazeRenderer::MazeRenderer(FILE *out, unsigned int overlays) : out(out), overlays(overlays), width(0), drawn(false) {}
+
+bool MazeRenderer::parseOverlays(const std::string &names, unsigned int *overlays) {
+  *overlays = NONE;
+  std::stringstream ss(names);
+  std::string name;
+  while (std::getline(ss, name, ',')) {
+    if (name == "path") {
+      *overlays |= PATH;
+    } else if (name == "weights") {
+      *overlays |= WEIGHTS;
+    } else if (name == "visited") {
+      *overlays |= VISITED;
+    } else if (!name.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void MazeRenderer::setOverlays(unsigned int overlays) {
+  this->overlays = overlays;
+  invalidate();
+}
+
+void MazeRenderer::invalidate() {
+  drawn = false;
+}
+
+size_t MazeRenderer::lastFrameBytes() const {
+  return buffer.size();
+}
+
+void MazeRenderer::draw(Mouse &mouse) {
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  const unsigned int floor_width = (overlays & WEIGHTS) ? 3 : 1;
+  width = SIZE * (1 + floor_width) + 1;
+  current.assign(width * SIZE, {' ', 0});
+
+  AbstractMaze *maze = mouse.maze;
+  const MazeWalls &walls = maze->walls;
+
+  // the background of each floor, path over visited
+  uint8_t background[SIZE][SIZE] = {};
+  if (overlays & VISITED) {
+    for (unsigned int r = 0; r < SIZE; r++) {
+      for (unsigned int c = 0; c < SIZE; c++) {
+        background[r][c] = maze->node(r, c).visited ? BLUE : 0;
+      }
+    }
+  }
+  if (overlays & PATH) {
+    unsigned int r = mouse.getRow();
+    unsigned int c = mouse.getCol();
+    for (const motion_primitive_t &prim : maze->path_to_next_goal) {
+      for (unsigned int i = 0; i < prim.n && r < SIZE && c < SIZE; i++) {
+        r += dir_row_delta(prim.d);
+        c += dir_col_delta(prim.d);
+        if (r < SIZE && c < SIZE) {
+          background[r][c] = GREEN;
+        }
+      }
+    }
+  }
+
+  const DistanceField *field = nullptr;
+  if (overlays & WEIGHTS) {
+    const unsigned int C = smartmouse::maze::CENTER_CORNER;
+    const unsigned int N = smartmouse::maze::CENTER_CELLS;
+    field = &maze->distance_field(C, C, N, N);
+  }
+
+  for (unsigned int r = 0; r < SIZE; r++) {
+    glyph_t *g = &current[r * width];
+    for (unsigned int c = 0; c < SIZE; c++) {
+      const bool south_wall = walls.is_wall(r, c, Direction::S);
+      *(g++) = {walls.is_wall(r, c, Direction::W) ? '|' : '_', 0};
+
+      glyph_t *floor = g;
+      if (field) {
+        const uint8_t attributes = background[r][c] | (south_wall ? UNDERLINE : 0);
+        const uint16_t d = field->distance(r, c);
+        char digits[4] = "   ";
+        if (d != DistanceField::UNREACHABLE) {
+          snprintf(digits, sizeof(digits), "%3u", std::min<unsigned int>(d, 999));
+        }
+        for (unsigned int i = 0; i < 3; i++) {
+          *(g++) = {digits[i], attributes};
+        }
+      } else {
+        *(g++) = {south_wall ? '_' : ' ', background[r][c]};
+      }
+
+      if (r == mouse.getRow() && c == mouse.getCol()) {
+        const Direction dir = mouse.getDir();
+        glyph_t &middle = floor[floor_width / 2];
+        middle.c = is_valid_dir(dir) ? "^>v<"[static_cast<int>(dir)] : 'o';
+        middle.attributes |= BOLD;
+      }
+    }
+    *g = {'|', 0};
+  }
+}
+
+void MazeRenderer::appendAttributes(uint8_t attributes) {
+  buffer += "\x1b[0";
+  if (attributes & BOLD) {
+    buffer += ";1";
+  }
+  if (attributes & UNDERLINE) {
+    buffer += ";4";
+  }
+  if (attributes & GREEN) {
+    buffer += ";42";
+  } else if (attributes & BLUE) {
+    buffer += ";44";
+  }
+  buffer += "m";
+}
+
+void MazeRenderer::render(Mouse &mouse) {
+  draw(mouse);
+  buffer.clear();
+
+  if (!drawn || previous.size() != current.size()) {
+    // start over from a blank screen, so every glyph that isn't a space is a change
+    previous.assign(current.size(), {' ', 0});
+    buffer += "\x1b[2J";
+    drawn = true;
+  }
+
+  // the cursor is only moved when the next change isn't right where the last one left it
+  const unsigned int rows = current.size() / width;
+  uint8_t attributes = 0;
+  bool cursor_known = false;
+  unsigned int cursor = 0;
+  for (unsigned int i = 0; i < current.size(); i++) {
+    if (current[i] == previous[i]) {
+      continue;
+    }
+    // rewriting a few unchanged glyphs is shorter than moving over them, as long as they don't need new attributes
+    if (cursor_known && i > cursor && i - cursor <= 4 && i / width == cursor / width) {
+      bool same_attributes = true;
+      for (unsigned int j = cursor; j < i; j++) {
+        same_attributes &= current[j].attributes == attributes;
+      }
+      if (same_attributes) {
+        for (; cursor < i; cursor++) {
+          buffer += current[cursor].c;
+        }
+      }
+    }
+    if (!cursor_known || cursor != i) {
+      char move[16];
+      snprintf(move, sizeof(move), "\x1b[%u;%uH", i / width + 1, i % width + 1);
+      buffer += move;
+    }
+    if (current[i].attributes != attributes) {
+      appendAttributes(current[i].attributes);
+      attributes = current[i].attributes;
+    }
+    buffer += current[i].c;
+    cursor_known = true;
+    cursor = i + 1;
+    // the terminal doesn't wrap to the next row of the frame, so make it move again there
+    if (cursor % width == 0) {
+      cursor_known = false;
+    }
+  }
+
+  // leave the cursor under the maze, so anything else printed doesn't land on top of it
+  if (!buffer.empty()) {
+    if (attributes != 0) {
+      appendAttributes(0);
+    }
+    char move[16];
+    snprintf(move, sizeof(move), "\x1b[%u;1H", rows + 1);
+    buffer += move;
+    fwrite(buffer.data(), 1, buffer.size(), out);
+    fflush(out);
+  }
+
+  previous.swap(current);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <common/core/Mouse.h>
+
+/**
+ * \brief draws a mouse in its maze on a terminal, fast enough to watch every step of a long run.
+ * The last frame stays on screen, and each new frame only rewrites the characters that changed,
+ * jumping between them with ANSI cursor moves, so a step usually costs a few dozen bytes instead of the whole maze.
+ * Cells are drawn like Mouse::print_maze_mouse, a west wall followed by a floor that's _ when there's a south wall.
+ */
+class MazeRenderer {
+public:
+  enum Overlay : unsigned int {
+    NONE = 0,
+    /** \brief the cells of maze->path_to_next_goal from the mouse, on green */
+    PATH = 1u << 0,
+    /** \brief each cell's distance to the center in the mouse's maze. Floors are 3 wide and underlined for walls */
+    WEIGHTS = 1u << 1,
+    /** \brief the cells the mouse has been to, on blue */
+    VISITED = 1u << 2,
+  };
+
+  explicit MazeRenderer(FILE *out = stdout, unsigned int overlays = NONE);
+
+  /** \brief parse a comma separated list like "path,weights,visited"
+   * \return false if any of the names isn't an overlay
+   */
+  static bool parseOverlays(const std::string &names, unsigned int *overlays);
+
+  /** \brief change the overlays. The layout might change, so the next frame is drawn in full */
+  void setOverlays(unsigned int overlays);
+
+  /** \brief clear the screen and draw the next frame in full, for when something else has written to the terminal */
+  void invalidate();
+
+  /** \brief draw the mouse and its maze, writing only what changed since the last frame */
+  void render(Mouse &mouse);
+
+  /** \return how many bytes the last render wrote, which is 0 if nothing changed */
+  size_t lastFrameBytes() const;
+
+private:
+  enum Attribute : uint8_t {
+    BOLD = 1u << 0,
+    UNDERLINE = 1u << 1,
+    GREEN = 1u << 2,
+    BLUE = 1u << 3,
+  };
+
+  struct glyph_t {
+    char c;
+    uint8_t attributes;
+
+    bool operator==(const glyph_t &other) const {
+      return c == other.c && attributes == other.attributes;
+    }
+  };
+
+  /** \brief fill current with the glyphs of the frame, row by row */
+  void draw(Mouse &mouse);
+
+  /** \brief append the escape sequence that switches the terminal to these attributes */
+  void appendAttributes(uint8_t attributes);
+
+  FILE *out;
+  unsigned int overlays;
+
+  /** \brief glyphs per row of the frame, including the east wall at the end */
+  unsigned int width;
+
+  std::vector<glyph_t> previous;
+  std::vector<glyph_t> current;
+
+  /** \brief the bytes of the frame are collected here, so each frame is one write */
+  std::string buffer;
+  bool drawn;
+};
@@ -9,6 +9,10 @@ void ForwardN::initialize() {
 
 void ForwardN::execute() {
   mouse->internalForward();
+  if (mouse->live_renderer) {
+    mouse->live_renderer->render(*mouse);
+    return;
+  }
   std::cin.get();
   mouse->print_maze_mouse();
 }
@@ -3,6 +3,7 @@
 #include <common/commanduino/CommanDuino.h>
 #include <common/core/Mouse.h>
 #include <common/core/Pose.h>
+#include <console/ConsoleMouse.h>
 
 class ForwardN : public Command {
 public:
@@ -19,6 +20,6 @@ public:
 private:
   unsigned int n;
   unsigned int i;
-  Mouse *mouse;
+  ConsoleMouse *mouse;
 };
 
@@ -11,8 +11,9 @@
 
 int main(int argc, char *argv[]) {
   int c, row = 0, col = 0;
+  bool live = false;
   opterr = 0;
-  while ((c = getopt(argc, argv, "r:c:")) != -1) {
+  while ((c = getopt(argc, argv, "r:c:l")) != -1) {
     switch (c) {
       case 'r':
         row = atoi(optarg);
@@ -20,6 +21,9 @@ int main(int argc, char *argv[]) {
       case 'c':
         col = atoi(optarg);
         break;
+      case 'l':
+        live = true;
+        break;
       case '?':
         if (optopt == 'r' || optopt == 'c')
           fprintf(stderr, "Option -%c requires an argument.\n", optopt);
@@ -36,10 +40,11 @@ int main(int argc, char *argv[]) {
   }
 
   if (argc < 3) {
-    printf("USAGE: Animate maze path [-r row] [-c col]\n");
+    printf("USAGE: Animate maze path [-r row] [-c col] [-l]\n");
     printf("the maze is the maze file to run the path in\n");
     printf("the path argument should be a string of N, S, E, and W.\n");
     printf("row the start row, col is the starting col\n");
+    printf("-l redraws the maze in place at each step, with the path so far shown as visited\n");
     exit(0);
   }
 
@@ -57,17 +62,29 @@ int main(int argc, char *argv[]) {
     std::cout << "start pos: (" << row << "," << col << ")" << std::endl;
 
     AbstractMaze maze(fs);
-    ConsoleMouse::inst()->seedMaze(&maze);
+    ConsoleMouse *mouse = ConsoleMouse::inst();
+    mouse->seedMaze(&maze);
+    mouse->maze->set_walls(maze.walls);
+
+    MazeRenderer renderer(stdout, MazeRenderer::VISITED);
+    auto show = [&]() {
+      if (live) {
+        mouse->mark_mouse_position_visited();
+        renderer.render(*mouse);
+      } else {
+        mouse->print_maze_mouse();
+      }
+    };
 
     unsigned int i = 0;
-    while (ConsoleMouse::inst()->inBounds() && i < path.length()) {
-      ConsoleMouse::inst()->print_maze_mouse();
-      ConsoleMouse::inst()->internalTurnToFace(char_to_dir(path.at(i++)));
-      ConsoleMouse::inst()->internalForward();
+    while (mouse->inBounds() && i < path.length()) {
+      show();
+      mouse->internalTurnToFace(char_to_dir(path.at(i++)));
+      mouse->internalForward();
       std::cin.get();
     }
 
-    ConsoleMouse::inst()->print_maze_mouse();
+    show();
     fs.close();
     return EXIT_SUCCESS;
   } else {
@@ -1,34 +1,81 @@
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include <common/commanduino/CommanDuino.h>
 #include <common/commands/SolveCommand.h>
 #include <console/ConsoleMouse.h>
 #include <console/ConsoleTimer.h>
+#include <common/core/AStar.h>
+#include <common/core/DStarLite.h>
 #include <common/core/Flood.h>
+#include <common/core/SolverRegistry.h>
+#include <common/KinematicController/RouteTiming.h>
+#include <common/core/MazeParser.h>
 #include <cstring>
 #include <common/core/util.h>
 
+void usage() {
+  printf("USAGE: ConsoleSolve [-q] [--live] [--overlay path,weights,visited] [--solver NAME] [--param K=V ...] "
+         "[maze.mz]\n");
+  printf("--live redraws the maze in place after every step instead of waiting for enter\n");
+  printf("the solver defaults to flood, and each --param sets one of its parameters:\n%s",
+         SolverRegistry::describe().c_str());
+}
+
 int main(int argc, char *argv[]) {
 
   std::string maze_file;
-  bool rand = false;
-  if (argc <= 1) {
-    rand = true;
-    printf("Using random maze\n");
-  }
-  else if (argc == 2) {
-    if (strncmp(argv[1], "-q", 2) == 0) {
+  bool live = false;
+  unsigned int overlays = MazeRenderer::NONE;
+  solver_choice_t choice;
+  SolverRegistry::choose("flood", &choice);
+  std::vector<const char *> params;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--live") == 0) {
+      live = true;
+    } else if (strcmp(argv[i], "--overlay") == 0 && i + 1 < argc) {
+      if (!MazeRenderer::parseOverlays(argv[++i], &overlays)) {
+        printf("overlays are a comma separated list of path, weights, and visited\n");
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--solver") == 0 && i + 1 < argc) {
+      if (!SolverRegistry::choose(argv[++i], &choice)) {
+        printf("there's no solver called %s\n", argv[i]);
+        usage();
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--param") == 0 && i + 1 < argc) {
+      params.push_back(argv[++i]);
+    } else if (strncmp(argv[i], "-q", 2) == 0) {
       GlobalProgramSettings.quiet = true;
-      rand = true;
+    } else if (argv[i][0] == '-') {
+      usage();
+      return EXIT_FAILURE;
+    } else {
+      maze_file = std::string(argv[i]);
     }
-    else {
-      maze_file= std::string(argv[1]);
+  }
+
+  // parameters can come before the solver they're for, so they're only set once the solver is known
+  for (const char *param : params) {
+    if (!SolverRegistry::set_param(&choice, param)) {
+      printf("%s isn't a parameter of %s\n", param, SolverRegistry::entry(choice.index).name);
+      usage();
+      return EXIT_FAILURE;
     }
   }
-  else if (argc == 3) {
-    maze_file = std::string(argv[2]);
+
+  bool rand = maze_file.empty();
+  if (rand && !GlobalProgramSettings.quiet) {
+    printf("Using random maze\n");
+  }
+
+  // drawing in place replaces the printing and waiting for enter of the normal mode
+  MazeRenderer renderer(stdout, overlays);
+  if (live) {
     GlobalProgramSettings.quiet = true;
+    ConsoleMouse::inst()->live_renderer = &renderer;
   }
 
   std::ifstream fs;
@@ -39,8 +86,14 @@ int main(int argc, char *argv[]) {
     ConsoleMouse::inst()->seedMaze(&maze);
   } else {
     if (fs.good()) {
-      AbstractMaze m(fs);
-      ConsoleMouse::inst()->seedMaze(&m);
+      try {
+        AbstractMaze m(fs);
+        ConsoleMouse::inst()->seedMaze(&m);
+      }
+      catch (MazeParseError &e) {
+        printf("%s: %s\n", maze_file.c_str(), e.what());
+        return EXIT_FAILURE;
+      }
     } else {
         printf("error opening maze file!\n");
       fs.close();
@@ -51,12 +104,27 @@ int main(int argc, char *argv[]) {
   Command::setTimerImplementation(&timer);
 
   Scheduler *scheduler;
-  Flood *flood = new Flood(ConsoleMouse::inst());
-  scheduler = new Scheduler(new SolveCommand(flood));
+  const route_timing_t timing = smartmouse::kc::route_timing(smartmouse::kc::ARC_TURN);
+  Solver *solver = SolverRegistry::create(choice, ConsoleMouse::inst(), &timing);
+  scheduler = new Scheduler(new SolveCommand(solver));
 
   while (!scheduler->run());
 
-  if (flood->isSolvable()) {
+  // how much work each kind of solver did, for comparing them
+  if (Flood *flood = dynamic_cast<Flood *>(solver)) {
+    const RouteCache &cache = flood->getRouteCache();
+    printf("route cache: %lu hits, %lu misses\n", cache.hits, cache.misses);
+    printf("cells flooded or repaired: %lu\n", flood->getCellsUpdated());
+  } else if (AStar *astar = dynamic_cast<AStar *>(solver)) {
+    printf("cells expanded: %lu\n", astar->total_nodes_expanded);
+  } else if (DStarLite *dstar = dynamic_cast<DStarLite *>(solver)) {
+    printf("cells expanded: %lu\n", dstar->total_nodes_expanded);
+  }
+  const route_t &fastest_route = ConsoleMouse::inst()->maze->fastest_route;
+  printf("fastest route: %s, %.2f s predicted\n", route_to_string(fastest_route).c_str(),
+         TimedRoutePlanner::time(timing, fastest_route, Direction::E));
+
+  if (solver->isSolvable()) {
     return EXIT_SUCCESS;
   } else {
     return EXIT_FAILURE;
@@ -0,0 +1,202 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#include <common/core/MazeCorpus.h>
+#include <common/core/MazeParser.h>
+
+/**
+ * \brief packs .mz files into a corpus and unpacks them again, drops mazes that are mirror images of ones before them,
+ * times how long it takes to open a corpus and look at every maze in it,
+ * and times how fast .mz files are parsed.
+ */
+
+void usage() {
+  printf("USAGE: ConvertCorpus pack corpus.mzc maze.mz [maze.mz ...]\n");
+  printf("       ConvertCorpus unpack corpus.mzc directory\n");
+  printf("       ConvertCorpus unpack corpus.mzc mazes.mz\n");
+  printf("       ConvertCorpus dedup corpus.mzc unique.mzc\n");
+  printf("       ConvertCorpus time corpus.mzc\n");
+  printf("       ConvertCorpus parse maze.mz [maze.mz ...]\n");
+  printf("a .mz file can hold any number of mazes, one after the other\n");
+}
+
+int pack(const char *corpus_file, int mz_count, char *mz_files[]) {
+  MazeCorpusWriter writer;
+  for (int i = 0; i < mz_count; i++) {
+    try {
+      for (const MazeWalls &walls : MazeParser::parse_file(mz_files[i])) {
+        writer.add(walls, mz_files[i]);
+      }
+    }
+    catch (MazeParseError &e) {
+      printf("skipped %s\n", e.what());
+    }
+  }
+
+  if (!writer.save(corpus_file)) {
+    printf("error writing %s\n", corpus_file);
+    return EXIT_FAILURE;
+  }
+  printf("packed %u mazes into %s\n", writer.count(), corpus_file);
+  return EXIT_SUCCESS;
+}
+
+int unpack(const char *corpus_file, const std::string &directory) {
+  MazeCorpusReader reader;
+  if (!reader.open(corpus_file)) {
+    printf("error opening %s, or it isn't a corpus of %ux%u mazes\n", corpus_file, smartmouse::maze::SIZE,
+           smartmouse::maze::SIZE);
+    return EXIT_FAILURE;
+  }
+
+  // unpacking into a .mz file puts all the mazes in that one file
+  const std::string extension = ".mz";
+  if (directory.size() > extension.size()
+      && directory.compare(directory.size() - extension.size(), extension.size(), extension) == 0) {
+    std::ofstream fs;
+    fs.open(directory, std::ofstream::out);
+    for (unsigned int i = 0; i < reader.count(); i++) {
+      fs << reader.mz(i);
+    }
+    if (!fs.good()) {
+      printf("error writing %s\n", directory.c_str());
+      return EXIT_FAILURE;
+    }
+    printf("unpacked %u mazes into %s\n", reader.count(), directory.c_str());
+    return EXIT_SUCCESS;
+  }
+
+  for (unsigned int i = 0; i < reader.count(); i++) {
+    // mazes packed from files keep their file name, the others are numbered
+    std::string name = reader.name(i);
+    name = name.substr(name.find_last_of('/') + 1);
+    if (name.empty()) {
+      name = std::to_string(i) + ".mz";
+    }
+
+    std::ofstream fs;
+    fs.open(directory + "/" + name, std::ofstream::out);
+    if (!fs.good()) {
+      printf("error writing %s/%s\n", directory.c_str(), name.c_str());
+      return EXIT_FAILURE;
+    }
+    fs << reader.mz(i);
+  }
+  printf("unpacked %u mazes into %s\n", reader.count(), directory.c_str());
+  return EXIT_SUCCESS;
+}
+
+int dedup(const char *corpus_file, const char *unique_file) {
+  MazeCorpusReader reader;
+  if (!reader.open(corpus_file)) {
+    printf("error opening %s, or it isn't a corpus of %ux%u mazes\n", corpus_file, smartmouse::maze::SIZE,
+           smartmouse::maze::SIZE);
+    return EXIT_FAILURE;
+  }
+
+  // mazes with the same fingerprint are compared in full, so a collision never drops a maze that's really different
+  auto t0 = std::chrono::steady_clock::now();
+  MazeCorpusWriter writer;
+  std::unordered_multimap<uint64_t, unsigned int> seen;
+  for (unsigned int i = 0; i < reader.count(); i++) {
+    const MazeWalls canonical = reader.walls(i).canonical();
+    const uint64_t fingerprint = canonical.zobrist_hash();
+
+    bool duplicate = false;
+    auto range = seen.equal_range(fingerprint);
+    for (auto it = range.first; it != range.second && !duplicate; ++it) {
+      duplicate = reader.walls(it->second).canonical() == canonical;
+    }
+    if (!duplicate) {
+      seen.emplace(fingerprint, i);
+      writer.add(reader.walls(i), reader.name(i), reader.metadata(i));
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  if (!writer.save(unique_file)) {
+    printf("error writing %s\n", unique_file);
+    return EXIT_FAILURE;
+  }
+  printf("kept %u of %u mazes in %.3f ms\n", writer.count(), reader.count(),
+         std::chrono::duration<double, std::milli>(t1 - t0).count());
+  return EXIT_SUCCESS;
+}
+
+int time_corpus(const char *corpus_file) {
+  auto t0 = std::chrono::steady_clock::now();
+  MazeCorpusReader reader;
+  if (!reader.open(corpus_file)) {
+    printf("error opening %s, or it isn't a corpus of %ux%u mazes\n", corpus_file, smartmouse::maze::SIZE,
+           smartmouse::maze::SIZE);
+    return EXIT_FAILURE;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  // counting the walls of every maze makes sure every page of walls is actually read
+  unsigned long long walls = 0;
+  for (unsigned int i = 0; i < reader.count(); i++) {
+    const MazeWalls &w = reader.walls(i);
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      walls += __builtin_popcount(w.horizontal[r]) + __builtin_popcount(w.vertical[r]);
+    }
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  printf("opened %u mazes in %.3f ms, counted their %llu walls in %.3f ms\n", reader.count(),
+         std::chrono::duration<double, std::milli>(t1 - t0).count(), walls,
+         std::chrono::duration<double, std::milli>(t2 - t1).count());
+  return EXIT_SUCCESS;
+}
+
+int parse(int mz_count, char *mz_files[]) {
+  unsigned long mazes = 0;
+  double total_s = 0;
+  for (int i = 0; i < mz_count; i++) {
+    std::ifstream fs(mz_files[i], std::ifstream::in | std::ifstream::binary);
+    if (!fs.good()) {
+      printf("error opening %s\n", mz_files[i]);
+      return EXIT_FAILURE;
+    }
+    const std::string contents((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+
+    // only the parsing is timed, not reading the file
+    auto t0 = std::chrono::steady_clock::now();
+    try {
+      MazeParser parser(contents.data(), contents.size(), mz_files[i]);
+      MazeWalls walls;
+      while (parser.next(&walls)) {
+        mazes++;
+      }
+    }
+    catch (MazeParseError &e) {
+      printf("%s\n", e.what());
+      return EXIT_FAILURE;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    total_s += std::chrono::duration<double>(t1 - t0).count();
+  }
+
+  printf("parsed %lu mazes in %.3f ms, %.0f mazes per second\n", mazes, total_s * 1000, mazes / total_s);
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+  if (argc >= 4 && strcmp(argv[1], "pack") == 0) {
+    return pack(argv[2], argc - 3, argv + 3);
+  } else if (argc == 4 && strcmp(argv[1], "unpack") == 0) {
+    return unpack(argv[2], argv[3]);
+  } else if (argc == 4 && strcmp(argv[1], "dedup") == 0) {
+    return dedup(argv[2], argv[3]);
+  } else if (argc == 3 && strcmp(argv[1], "time") == 0) {
+    return time_corpus(argv[2]);
+  } else if (argc >= 3 && strcmp(argv[1], "parse") == 0) {
+    return parse(argc - 2, argv + 2);
+  }
+
+  usage();
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <common/core/AbstractMaze.h>
+#include <common/core/AStar.h>
+#include <common/core/DStarLite.h>
+#include <common/core/Flood.h>
+#include <common/core/MazeParser.h>
+#include <common/core/WavefrontFlood.h>
+#include <console/ConsoleMouse.h>
+
+/**
+ * \brief times flooding from every cell to the center, and reports the worst and average case.
+ * Compares the old recursive Node::assign_weights_to_neighbors against the breadth first AbstractMaze::assign_weights
+ * and the bit-parallel wavefront_assign_weights.
+ * Then it senses the walls of the maze one cell at a time starting from no walls, like exploring does,
+ * and compares repairing the DistanceField after each cell against computing it again from scratch.
+ * Last it explores each maze from the start to the center and back with Flood, AStar, and DStarLite,
+ * and times every planNextStep, along with the mean cells each of them looked at per step.
+ */
+
+struct timing_t {
+  double worst_us;
+  double total_us;
+  unsigned int runs;
+};
+
+/** \brief the fastest of several runs is used for each cell, so that preemption doesn't show up as the worst case */
+template<typename F>
+double best_of(int repeats, F f) {
+  double best_us = -1;
+  for (int k = 0; k < repeats; k++) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    if (best_us < 0 || us < best_us) {
+      best_us = us;
+    }
+  }
+  return best_us;
+}
+
+void record(timing_t *t, double us) {
+  t->worst_us = std::max(t->worst_us, us);
+  t->total_us += us;
+  t->runs++;
+}
+
+/** \brief explore to the center and back, timing each step. Planning changes what the mouse knows, so each step can
+ * only be timed once
+ */
+timing_t explore(Solver *solver) {
+  timing_t plan = {0, 0, 0};
+  solver->setup();
+  for (Solver::Goal goal : {Solver::Goal::CENTER, Solver::Goal::START}) {
+    solver->setGoal(goal);
+    while (!solver->isFinished()) {
+      auto t0 = std::chrono::steady_clock::now();
+      const motion_primitive_t prim = solver->planNextStep();
+      auto t1 = std::chrono::steady_clock::now();
+      record(&plan, std::chrono::duration<double, std::micro>(t1 - t0).count());
+      solver->mouse->internalTurnToFace(prim.d);
+      solver->mouse->internalForward();
+    }
+  }
+  return plan;
+}
+
+void print_solver(const std::string &maze_file, const char *solver, const timing_t &plan, unsigned long cells) {
+  printf("%-24s %-12s %12u %12.2f %12.2f %12.1f\n", maze_file.c_str(), solver, plan.runs, plan.worst_us,
+         plan.total_us / std::max(plan.runs, 1u), (double) cells / std::max(plan.runs, 1u));
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    printf("USAGE: FloodBenchmark maze.mz [maze.mz ...]\n");
+    printf("floods from every cell to the center and reports the times in microseconds\n");
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int C = smartmouse::maze::CENTER;
+  const int repeats = 10;
+
+  std::vector<std::pair<std::string, AbstractMaze>> mazes;
+  printf("%-24s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s\n", "maze", "rec worst", "rec mean", "bfs worst",
+         "bfs mean", "wave worst", "wave mean", "full worst", "full mean", "repair worst", "repair mean");
+  for (int arg = 1; arg < argc; arg++) {
+    std::string maze_file(argv[arg]);
+    std::ifstream fs;
+    fs.open(maze_file, std::ifstream::in);
+    if (!fs.good()) {
+      printf("error opening maze file %s\n", maze_file.c_str());
+      continue;
+    }
+
+    AbstractMaze maze;
+    try {
+      maze = AbstractMaze(fs);
+    }
+    catch (MazeParseError &e) {
+      printf("%-24s skipped, %s\n", maze_file.c_str(), e.what());
+      continue;
+    }
+
+    timing_t recursive = {0, 0, 0};
+    timing_t bfs = {0, 0, 0};
+    timing_t wave = {0, 0, 0};
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        record(&recursive, best_of(repeats, [&]() {
+          bool success = false;
+          maze.reset();
+          maze.node(r, c).assign_weights_to_neighbors(&maze.node(C, C), 0, &success);
+        }));
+
+        record(&bfs, best_of(repeats, [&]() {
+          maze.reset();
+          maze.assign_weights(r, c, C, C);
+        }));
+
+        record(&wave, best_of(repeats, [&]() {
+          maze.reset();
+          wavefront_assign_weights(&maze, r, c, C, C);
+        }));
+      }
+    }
+
+    timing_t full = {0, 0, 0};
+    timing_t repair = {0, 0, 0};
+    AbstractMaze explored;
+    explored.connect_all_neighbors_in_maze();
+    explored.distance_field(C, C);
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        auto t0 = std::chrono::steady_clock::now();
+        for (Direction d = Direction::First; d < Direction::Last; d++) {
+          if (maze.walls.is_wall(r, c, d)) {
+            explored.disconnect_neighbor(r, c, d);
+          }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        record(&repair, std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+        record(&full, best_of(repeats, [&]() {
+          DistanceField field;
+          field.compute(explored.walls, C, C);
+        }));
+      }
+    }
+
+    mazes.emplace_back(maze_file, maze);
+    printf("%-24s %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f %12.2f\n", maze_file.c_str(),
+           recursive.worst_us, recursive.total_us / recursive.runs, bfs.worst_us, bfs.total_us / bfs.runs,
+           wave.worst_us, wave.total_us / wave.runs, full.worst_us, full.total_us / full.runs, repair.worst_us,
+           repair.total_us / repair.runs);
+  }
+
+  printf("\n%-24s %-12s %12s %12s %12s %12s\n", "maze", "solver", "steps", "plan worst", "plan mean", "cells/step");
+  ConsoleMouse *mouse = ConsoleMouse::inst();
+  for (auto &maze : mazes) {
+    mouse->seedMaze(&maze.second);
+
+    Flood flood(mouse);
+    const timing_t flood_plan = explore(&flood);
+    print_solver(maze.first, "flood", flood_plan, flood.getCellsUpdated());
+
+    AStar astar(mouse);
+    const timing_t astar_plan = explore(&astar);
+    print_solver(maze.first, "astar", astar_plan, astar.total_nodes_expanded);
+
+    DStarLite dstar(mouse);
+    const timing_t dstar_plan = explore(&dstar);
+    print_solver(maze.first, "dstarlite", dstar_plan, dstar.total_nodes_expanded);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -1,39 +1,99 @@
 #include <console/ConsoleMouse.h>
+#include <common/core/MazeCorpus.h>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
-int main(int argc, char *argv[]) {
+/**
+ * \brief makes random mazes. The same seed always makes the same mazes, however many threads make them,
+ * so a corpus can be made again from just its seed and count.
+ */
 
-  srand(time(0));
+void usage() {
+  printf("USAGE: GenerateMaze [--count N] [--seed S] [--threads T] [output]\n");
+  printf("the output is a corpus if it ends in .mzc, and a .mz file of all the mazes otherwise.\n");
+  printf("without an output the mazes are printed. The seed defaults to the time, and threads to every core.\n");
+}
 
-  std::string maze_file;
-  std::ofstream fs;
-  bool save = false;
-  if (argc == 2) {
-    maze_file = argv[1];
+bool ends_with(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
 
-    fs.open(maze_file, std::ofstream::out);
+int main(int argc, char *argv[]) {
+  unsigned int count = 1;
+  uint32_t seed = time(0);
+  unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string output;
 
-    if (fs.good()) {
-      save = true;
-      std::cout << "saving to file: [" << maze_file << "]" << std::endl;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+      count = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+    } else if (argv[i][0] != '-' && output.empty()) {
+      output = argv[i];
     } else {
-      std::cout << "error opening file: [" << maze_file << "]" << std::endl;
-      fs.close();
+      usage();
       return EXIT_FAILURE;
     }
   }
+  threads = std::min(threads, std::max(count, 1u));
 
-  //generate maze
-  AbstractMaze maze = AbstractMaze::gen_random_legal_maze();
-
-  maze.print_maze();
+  // each thread makes one contiguous block, so no two threads write to the same cache line
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<MazeWalls> mazes(count);
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; t++) {
+    const unsigned int begin = (uint64_t) count * t / threads;
+    const unsigned int end = (uint64_t) count * (t + 1) / threads;
+    workers.emplace_back([&mazes, seed, begin, end]() {
+      for (unsigned int i = begin; i < end; i++) {
+        mazes[i] = AbstractMaze::gen_random_legal_walls(seed, i);
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  auto t1 = std::chrono::steady_clock::now();
 
-  if (save) {
+  if (output.empty()) {
+    for (const MazeWalls &walls : mazes) {
+      AbstractMaze maze;
+      maze.set_walls(walls);
+      maze.print_maze();
+    }
+  } else if (ends_with(output, ".mzc")) {
+    MazeCorpusWriter writer;
+    for (unsigned int i = 0; i < count; i++) {
+      writer.add(mazes[i], "", "seed " + std::to_string(seed) + " index " + std::to_string(i));
+    }
+    if (!writer.save(output)) {
+      std::cout << "error writing file: [" << output << "]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  } else {
+    std::ofstream fs;
+    fs.open(output, std::ofstream::out);
     std::string buff;
     buff.resize(smartmouse::maze::BUFF_SIZE);
-    maze.print_maze_str(&buff[0]);
-    fs << buff << std::endl;
-    fs.close();
+    for (const MazeWalls &walls : mazes) {
+      AbstractMaze maze;
+      maze.set_walls(walls);
+      maze.print_maze_str(&buff[0]);
+      fs << buff.c_str();
+    }
+    if (!fs.good()) {
+      std::cout << "error writing file: [" << output << "]" << std::endl;
+      return EXIT_FAILURE;
+    }
   }
-}
 
+  // stderr, so it doesn't end up in the mazes when they're printed
+  fprintf(stderr, "generated %u mazes from seed %u on %u threads in %.3f ms\n", count, seed, threads,
+          std::chrono::duration<double, std::milli>(t1 - t0).count());
+  return EXIT_SUCCESS;
+}
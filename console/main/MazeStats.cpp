@@ -0,0 +1,128 @@
+#include <common/core/MazeCorpus.h>
+#include <common/core/MazeFeatures.h>
+#include <common/core/MazeParser.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+/**
+ * \brief writes the features of every maze in corpora and .mz files as CSV or JSON, see MazeFeatures.
+ * The mazes are analyzed on every core, but they're always written in the order they were read.
+ */
+
+void usage() {
+  printf("USAGE: MazeStats [--json] [--threads T] maze.mz|corpus.mzc [...]\n");
+  printf("writes CSV unless --json is given. Threads defaults to every core.\n");
+}
+
+bool ends_with(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/** \brief quote a name for CSV or JSON. Names are file names, so only quotes and backslashes need escaping.
+ * CSV escapes a quote by doubling it, and JSON escapes both with a backslash.
+ */
+std::string quote(const std::string &str, bool json) {
+  std::string quoted = "\"";
+  for (char c : str) {
+    if (c == '"') {
+      quoted += json ? '\\' : '"';
+    } else if (c == '\\' && json) {
+      quoted += '\\';
+    }
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+int main(int argc, char *argv[]) {
+  bool json = false;
+  unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::string> files;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = std::max(1ul, strtoul(argv[++i], nullptr, 10));
+    } else if (argv[i][0] != '-') {
+      files.push_back(argv[i]);
+    } else {
+      usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (files.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  // read everything first, so the threads only have to analyze
+  std::vector<MazeWalls> mazes;
+  std::vector<std::string> names;
+  for (const std::string &file : files) {
+    if (ends_with(file, ".mzc")) {
+      MazeCorpusReader reader;
+      if (!reader.open(file)) {
+        fprintf(stderr, "error opening %s, or it isn't a corpus of %ux%u mazes\n", file.c_str(),
+                smartmouse::maze::SIZE, smartmouse::maze::SIZE);
+        return EXIT_FAILURE;
+      }
+      for (unsigned int i = 0; i < reader.count(); i++) {
+        mazes.push_back(reader.walls(i));
+        names.push_back(file + ":" + std::to_string(i));
+      }
+    } else {
+      try {
+        unsigned int i = 0;
+        for (const MazeWalls &walls : MazeParser::parse_file(file)) {
+          mazes.push_back(walls);
+          names.push_back(file + ":" + std::to_string(i++));
+        }
+      }
+      catch (MazeParseError &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  const unsigned int count = mazes.size();
+  threads = std::min(threads, std::max(count, 1u));
+  std::vector<maze_features_t> features(count);
+  std::vector<std::thread> workers;
+  for (unsigned int t = 0; t < threads; t++) {
+    const unsigned int begin = (uint64_t) count * t / threads;
+    const unsigned int end = (uint64_t) count * (t + 1) / threads;
+    workers.emplace_back([&mazes, &features, begin, end]() {
+      for (unsigned int i = begin; i < end; i++) {
+        features[i] = MazeFeatures::analyze(mazes[i]);
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  if (json) {
+    printf("[\n");
+  } else {
+    printf("maze,dead_ends,loops,longest_straight,route_length,route_turns,shortest_routes\n");
+  }
+  for (unsigned int i = 0; i < count; i++) {
+    const maze_features_t &f = features[i];
+    if (json) {
+      printf("  {\"maze\": %s, \"dead_ends\": %u, \"loops\": %u, \"longest_straight\": %u, \"route_length\": %u, "
+             "\"route_turns\": %u, \"shortest_routes\": %llu}%s\n", quote(names[i], true).c_str(), f.dead_ends,
+             f.loops, f.longest_straight, f.route_length, f.route_turns, (unsigned long long) f.shortest_routes,
+             i + 1 < count ? "," : "");
+    } else {
+      printf("%s,%u,%u,%u,%u,%u,%llu\n", quote(names[i], false).c_str(), f.dead_ends, f.loops,
+             f.longest_straight, f.route_length, f.route_turns, (unsigned long long) f.shortest_routes);
+    }
+  }
+  if (json) {
+    printf("]\n");
+  }
+  return EXIT_SUCCESS;
+}
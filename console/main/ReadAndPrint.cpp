@@ -1,5 +1,6 @@
 #include <fstream>
 
+#include <common/core/MazeParser.h>
 #include <console/ConsoleMouse.h>
 
 int main(int argc, char *argv[]) {
@@ -14,9 +15,15 @@ int main(int argc, char *argv[]) {
   fs.open(maze_file, std::ifstream::in);
 
   if (fs.good()) {
-    AbstractMaze maze(fs);
-    ConsoleMouse::inst()->seedMaze(&maze);
-    maze.print_maze();
+    try {
+      AbstractMaze maze(fs);
+      ConsoleMouse::inst()->seedMaze(&maze);
+      maze.print_maze();
+    }
+    catch (MazeParseError &e) {
+      printf("%s: %s\n", maze_file.c_str(), e.what());
+      return EXIT_FAILURE;
+    }
     fs.close();
     return EXIT_SUCCESS;
   } else {
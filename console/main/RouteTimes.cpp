@@ -0,0 +1,132 @@
+#include <common/core/AbstractMaze.h>
+#include <common/core/DiagonalRoute.h>
+#include <common/core/MazeCorpus.h>
+#include <common/core/MazeParser.h>
+#include <common/core/TimedRoutePlanner.h>
+#include <common/KinematicController/RouteTiming.h>
+#include <cstring>
+
+/**
+ * \brief compares the route flood fill picks, which has the fewest cells, against the route TimedRoutePlanner picks,
+ * which is predicted to take the least time, and then against the faster of the two with its staircases cut
+ * diagonally by DiagonalPlanner, for every maze in some .mz files or corpora.
+ */
+
+void usage() {
+  printf("USAGE: RouteTimes [--arc] [--clearance CELLS] maze.mz|corpus.mzc [...]\n");
+  printf("predicts the seconds from the start to the center for the flood fill route, the fastest route,\n");
+  printf("and the faster of those with diagonals, turning in place unless --arc is given.\n");
+  printf("Diagonals keep clearance cells from every post, which defaults to half the track width.\n");
+}
+
+bool ends_with(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+unsigned int cells(const route_t &route) {
+  unsigned int n = 0;
+  for (const motion_primitive_t &prim : route) {
+    n += prim.n;
+  }
+  return n;
+}
+
+int main(int argc, char *argv[]) {
+  bool arc_turns = false;
+  double clearance = smartmouse::kc::TRACK_WIDTH_CU / 2;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--arc") == 0) {
+      arc_turns = true;
+    } else if (strcmp(argv[i], "--clearance") == 0 && i + 1 < argc) {
+      clearance = atof(argv[++i]);
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.empty()) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<MazeWalls> mazes;
+  std::vector<std::string> names;
+  for (const std::string &file : files) {
+    if (ends_with(file, ".mzc")) {
+      MazeCorpusReader reader;
+      if (!reader.open(file)) {
+        printf("%-32s skipped, it isn't a corpus of %ux%u mazes\n", file.c_str(), smartmouse::maze::SIZE,
+               smartmouse::maze::SIZE);
+        continue;
+      }
+      for (unsigned int i = 0; i < reader.count(); i++) {
+        mazes.push_back(reader.walls(i));
+        names.push_back(file + ":" + std::to_string(i));
+      }
+    } else {
+      try {
+        const std::vector<MazeWalls> parsed = MazeParser::parse_file(file);
+        for (unsigned int i = 0; i < parsed.size(); i++) {
+          mazes.push_back(parsed[i]);
+          names.push_back(parsed.size() > 1 ? file + ":" + std::to_string(i) : file);
+        }
+      }
+      catch (MazeParseError &e) {
+        printf("%-32s skipped, %s\n", file.c_str(), e.what());
+      }
+    }
+  }
+
+  const route_timing_t timing = smartmouse::kc::route_timing(arc_turns);
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+
+  printf("%-32s %11s %11s %11s %11s %11s %11s %9s %11s %11s %9s\n", "maze", "flood cells", "flood turns", "flood s",
+         "timed cells", "timed turns", "timed s", "saved", "staircases", "diagonal s", "saved");
+  double flood_total = 0;
+  double timed_total = 0;
+  double diagonal_total = 0;
+  for (unsigned int i = 0; i < mazes.size(); i++) {
+    // flood fill from the same start the mouse is reset to
+    DistanceField field;
+    field.compute(mazes[i], C, C, N, N);
+    route_t flood_route;
+    route_t timed_route;
+    double timed_s;
+    if (!field.route(mazes[i], &flood_route, 0, 0) ||
+        !TimedRoutePlanner::plan(timing, mazes[i], &timed_route, &timed_s, 0, 0, Direction::E, C, C, N, N)) {
+      printf("%-32s skipped, the center can't be reached\n", names[i].c_str());
+      continue;
+    }
+    const double flood_s = TimedRoutePlanner::time(timing, flood_route, Direction::E);
+
+    // the fewest cells usually means the most staircases, so it can be the faster one with diagonals
+    diagonal_route_t diagonal_route;
+    unsigned int staircases = 0;
+    double diagonal_s = 0;
+    for (const route_t *route : {&flood_route, &timed_route}) {
+      diagonal_route_t candidate;
+      const unsigned int cut = DiagonalPlanner::plan(mazes[i], *route, 0, 0, clearance, &candidate);
+      const double s = smartmouse::kc::diagonal_route_seconds(candidate, Direction::E, arc_turns);
+      if (diagonal_route.empty() || s < diagonal_s) {
+        diagonal_route = candidate;
+        staircases = cut;
+        diagonal_s = s;
+      }
+    }
+
+    flood_total += flood_s;
+    timed_total += timed_s;
+    diagonal_total += diagonal_s;
+    printf("%-32s %11u %11zu %11.3f %11u %11zu %11.3f %8.1f%% %11u %11.3f %8.1f%%\n", names[i].c_str(),
+           cells(flood_route), flood_route.size() - 1, flood_s, cells(timed_route), timed_route.size() - 1, timed_s,
+           100 * (flood_s - timed_s) / flood_s, staircases, diagonal_s, 100 * (timed_s - diagonal_s) / timed_s);
+  }
+
+  if (flood_total > 0) {
+    printf("%-32s %11s %11s %11.3f %11s %11s %11.3f %8.1f%% %11s %11.3f %8.1f%%\n", "total", "", "", flood_total, "",
+           "", timed_total, 100 * (flood_total - timed_total) / flood_total, "", diagonal_total,
+           100 * (timed_total - diagonal_total) / timed_total);
+  }
+  return EXIT_SUCCESS;
+}
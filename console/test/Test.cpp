@@ -1,14 +1,27 @@
 #include <common/core/AbstractMaze.h>
+#include <common/core/AStar.h>
 #include <common/core/Direction.h>
 #include <console/ConsoleMouse.h>
 #include <common/core/Mouse.h>
+#include <algorithm>
 #include <fstream>
 #include <common/core/WallFollow.h>
+#include <common/core/DiagonalRoute.h>
+#include <common/core/DStarLite.h>
 #include <common/core/Flood.h>
+#include <common/core/MazeCorpus.h>
+#include <common/core/MazeFeatures.h>
+#include <common/core/MazeKnowledge.h>
+#include <common/core/MazeParser.h>
+#include <common/core/MazeSnapshot.h>
 #include <common/core/Node.h>
+#include <common/core/SolverRegistry.h>
+#include <common/core/TimedRoutePlanner.h>
+#include <common/KinematicController/RouteTiming.h>
+#include <common/core/WavefrontFlood.h>
 #include "gtest/gtest.h"
 
-const char *FLOOD_SLN = "1E3S2E2S1W3S2E2N1E1N1E2S2E1S";
+const char *FLOOD_SLN = "1E3S2E2S1W3S2E2N1E1N1E2S1E";
 
 const char *WALL_FOLLOW_SLN =
 "9E1W1S1N1W2S2N1W3S2E1N1E1N1S1W1S1E2S3E1N2W2E3N1W2S1W1N1S1E2N1W1N1S1E1N1S1E1N3E10S5N1W2S3W1S2W2N2W2N2S1E2N2S1E2S1E2N3E1N1S3W2S1E1N3E3N1W1E1N1W1E1N1W1N1S1E3S1E5N1W1S1N2W5S3W2N3W1S4N1W2S1N1W1S3W1S2E1S1E1N1E1S1N1W1S1W1S1E1W2S2N1W3S2E2N1E1N1E2S1E";
@@ -132,6 +145,95 @@ TEST(ConnectMazeTest, RemoveNeighbors) {
   ASSERT_EQ(nSouth->neighbor(Direction::N), (Node *)NULL);
 }
 
+TEST(MazeWallsTest, WallsAreSharedByNeighbors) {
+  AbstractMaze maze;
+  maze.connect_neighbor(3, 4, Direction::E);
+  EXPECT_FALSE(maze.walls.is_wall(3, 4, Direction::E));
+  EXPECT_FALSE(maze.walls.is_wall(3, 5, Direction::W));
+
+  maze.disconnect_neighbor(3, 5, Direction::W);
+  EXPECT_TRUE(maze.walls.is_wall(3, 4, Direction::E));
+  EXPECT_TRUE(maze.walls.is_wall(3, 5, Direction::W));
+
+  maze.connect_neighbor(7, 2, Direction::N);
+  EXPECT_FALSE(maze.walls.is_wall(6, 2, Direction::S));
+}
+
+TEST(MazeWallsTest, PerimeterIsAlwaysAWall) {
+  AbstractMaze maze;
+  maze.connect_all_neighbors_in_maze();
+
+  for (unsigned int i = 0; i < smartmouse::maze::SIZE; i++) {
+    maze.connect_neighbor(0, i, Direction::N);
+    maze.connect_neighbor(i, 0, Direction::W);
+    maze.connect_neighbor(smartmouse::maze::SIZE - 1, i, Direction::S);
+    maze.connect_neighbor(i, smartmouse::maze::SIZE - 1, Direction::E);
+
+    EXPECT_TRUE(maze.walls.is_wall(0, i, Direction::N));
+    EXPECT_TRUE(maze.walls.is_wall(i, 0, Direction::W));
+    EXPECT_TRUE(maze.walls.is_wall(smartmouse::maze::SIZE - 1, i, Direction::S));
+    EXPECT_TRUE(maze.walls.is_wall(i, smartmouse::maze::SIZE - 1, Direction::E));
+  }
+
+  AbstractMaze other;
+  other.connect_all_neighbors_in_maze();
+  EXPECT_TRUE(maze == other);
+  EXPECT_EQ(0, memcmp(&maze.walls, &other.walls, sizeof(MazeWalls)));
+}
+
+TEST(MazeWallsTest, CopiedMazeOwnsItsNodes) {
+  AbstractMaze maze;
+  maze.connect_neighbor(0, 0, Direction::E);
+
+  AbstractMaze copy(maze);
+  EXPECT_TRUE(copy == maze);
+
+  Node *n = copy.node(0, 0).neighbor(Direction::E);
+  EXPECT_EQ(&copy.node(0, 1), n);
+
+  copy.disconnect_neighbor(0, 0, Direction::E);
+  EXPECT_FALSE(copy == maze);
+  EXPECT_EQ(&maze.node(0, 1), maze.node(0, 0).neighbor(Direction::E));
+}
+
+TEST(MazeWallsTest, MovedMazeKeepsItsWalls) {
+  AbstractMaze maze = AbstractMaze::gen_random_legal_maze();
+  AbstractMaze copy(maze);
+
+  AbstractMaze moved(std::move(maze));
+  EXPECT_TRUE(moved == copy);
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+      for (Direction d = Direction::First; d < Direction::Last; d++) {
+        ASSERT_EQ(moved.walls.is_wall(r, c, d), moved.node(r, c).wall(d));
+        ASSERT_EQ(moved.walls.is_wall(r, c, d), moved.node(r, c).neighbor(d) == nullptr);
+      }
+    }
+  }
+}
+
+TEST(MazeWallsTest, MirrorImagesShareAFingerprint) {
+  const Direction mirror[] = {Direction::W, Direction::S, Direction::E, Direction::N}; // of N, E, S, W
+  for (uint32_t i = 0; i < 20; i++) {
+    MazeWalls walls = AbstractMaze::gen_random_legal_walls(3, i);
+    MazeWalls t = walls.transposed();
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        for (Direction d = Direction::First; d < Direction::Last; d++) {
+          ASSERT_EQ(walls.is_wall(r, c, d), t.is_wall(c, r, mirror[static_cast<int>(d)]));
+        }
+      }
+    }
+    EXPECT_TRUE(t.transposed() == walls);
+
+    bool walls_transposed, t_transposed;
+    EXPECT_TRUE(walls.canonical(&walls_transposed) == t.canonical(&t_transposed));
+    EXPECT_NE(walls_transposed, t_transposed);
+    EXPECT_EQ(walls.fingerprint(), t.fingerprint());
+    EXPECT_NE(walls.fingerprint(), AbstractMaze::gen_random_legal_walls(3, i + 1).fingerprint());
+  }
+}
+
 TEST(FloodFillTest, EmptyMaze){
   std::string maze_file = "../../mazes/empty.mz";
   std::ifstream fs;
@@ -204,6 +306,628 @@ TEST(FloodFillTest, StripedMaze){
   }
 }
 
+TEST(FloodFillTest, BreadthFirstMatchesRecursive) {
+  std::string maze_file = "../../mazes/16x16.mz";
+  std::ifstream fs;
+  fs.open(maze_file, std::ifstream::in);
+
+  ASSERT_TRUE(fs.good());
+
+  AbstractMaze maze(fs);
+  AbstractMaze recursive(maze);
+
+  bool success = false;
+  recursive.reset();
+  recursive.node(0, 0).assign_weights_to_neighbors(&recursive.node(0, 0), 0, &success);
+
+  // flood towards the farthest node, so the breadth first search has to cover the whole maze
+  unsigned int far_r = 0, far_c = 0;
+  for (unsigned int i = 0; i < smartmouse::maze::SIZE; i++) {
+    for (unsigned int j = 0; j < smartmouse::maze::SIZE; j++) {
+      if (recursive.node(i, j).weight > recursive.node(far_r, far_c).weight) {
+        far_r = i;
+        far_c = j;
+      }
+    }
+  }
+
+  maze.reset();
+  ASSERT_TRUE(maze.assign_weights(0, 0, far_r, far_c));
+
+  for (unsigned int i = 0; i < smartmouse::maze::SIZE; i++) {
+    for (unsigned int j = 0; j < smartmouse::maze::SIZE; j++) {
+      if (maze.node(i, j).known) {
+        EXPECT_EQ(recursive.node(i, j).weight, maze.node(i, j).weight);
+      }
+    }
+  }
+
+  EXPECT_EQ(recursive.node(far_r, far_c).weight, maze.node(far_r, far_c).weight);
+}
+
+TEST(FloodFillTest, WavefrontMatchesBreadthFirst) {
+  const char *maze_files[] = {"../../mazes/16x16.mz", "../../mazes/empty.mz", "../../mazes/hard.mz",
+                              "../../mazes/competition_17.mz"};
+  for (auto maze_file : maze_files) {
+    std::ifstream fs;
+    fs.open(maze_file, std::ifstream::in);
+    ASSERT_TRUE(fs.good());
+
+    AbstractMaze maze(fs);
+    AbstractMaze wavefront(maze);
+
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        maze.reset();
+        wavefront.reset();
+        bool bfs_success = maze.assign_weights(0, 0, r, c);
+        bool wavefront_success = wavefront_assign_weights(&wavefront, 0, 0, r, c);
+        ASSERT_EQ(bfs_success, wavefront_success);
+
+        for (unsigned int i = 0; i < smartmouse::maze::SIZE; i++) {
+          for (unsigned int j = 0; j < smartmouse::maze::SIZE; j++) {
+            if (maze.node(i, j).known && wavefront.node(i, j).known) {
+              ASSERT_EQ(maze.node(i, j).weight, wavefront.node(i, j).weight);
+            }
+          }
+        }
+      }
+    }
+
+    route_t bfs_route, wavefront_route;
+    wavefront.flood_mode = FloodMode::WAVEFRONT;
+    const unsigned int C = smartmouse::maze::CENTER;
+    maze.flood_fill(&bfs_route, 0, 0, C, C);
+    wavefront.flood_fill(&wavefront_route, 0, 0, C, C);
+    EXPECT_EQ(route_to_string(bfs_route), route_to_string(wavefront_route));
+  }
+}
+
+TEST(DistanceFieldTest, RepairMatchesRecompute) {
+  srand(0);
+  AbstractMaze maze;
+  maze.connect_all_neighbors_in_maze();
+  const unsigned int C = smartmouse::maze::CENTER;
+  DistanceField &repaired = maze.distance_field(C, C);
+
+  for (int i = 0; i < 2000; i++) {
+    unsigned int r = rand() % smartmouse::maze::SIZE;
+    unsigned int c = rand() % smartmouse::maze::SIZE;
+    Direction d = static_cast<Direction>(rand() % 4);
+    if (rand() % 2) {
+      maze.disconnect_neighbor(r, c, d);
+    } else {
+      maze.connect_neighbor(r, c, d);
+    }
+
+    DistanceField fresh;
+    fresh.compute(maze.walls, C, C);
+    ASSERT_EQ(0, memcmp(fresh.dist, repaired.dist, sizeof(fresh.dist))) << "after change " << i;
+  }
+}
+
+TEST(DistanceFieldTest, IncrementalRouteIsShortest) {
+  std::ifstream fs;
+  fs.open("../../mazes/16x16.mz", std::ifstream::in);
+  ASSERT_TRUE(fs.good());
+  AbstractMaze maze(fs);
+
+  route_t flood_route, incremental_route;
+  const unsigned int C = smartmouse::maze::CENTER;
+  ASSERT_TRUE(maze.flood_fill(&flood_route, 0, 0, C, C));
+  ASSERT_TRUE(maze.incremental_flood_fill(&incremental_route, 0, 0, C, C));
+  EXPECT_EQ(flood_route.size(), incremental_route.size());
+}
+
+TEST(DistanceFieldTest, OneFieldAnswersEveryStart) {
+  std::ifstream fs;
+  fs.open("../../mazes/16x16.mz", std::ifstream::in);
+  ASSERT_TRUE(fs.good());
+  AbstractMaze maze(fs);
+
+  const unsigned int C = smartmouse::maze::CENTER;
+  const DistanceField &field = maze.distance_field(C, C);
+  EXPECT_EQ(Direction::INVALID, field.next_direction(maze.walls, C, C, Direction::N));
+
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+      route_t route;
+      if (!field.route(maze.walls, &route, r, c)) {
+        EXPECT_EQ(DistanceField::UNREACHABLE, field.distance(r, c));
+        continue;
+      }
+
+      unsigned int steps = 0;
+      for (motion_primitive_t prim : route) {
+        steps += prim.n;
+      }
+      EXPECT_EQ(field.distance(r, c), steps);
+
+      // whichever way we face, following next_direction takes the same number of steps
+      for (Direction facing = Direction::First; facing < Direction::Last; facing++) {
+        unsigned int row = r, col = c;
+        unsigned int moves = 0;
+        Direction d = facing;
+        while ((d = field.next_direction(maze.walls, row, col, d)) != Direction::INVALID) {
+          ASSERT_FALSE(maze.walls.is_wall(row, col, d));
+          row += (d == Direction::S) - (d == Direction::N);
+          col += (d == Direction::E) - (d == Direction::W);
+          moves++;
+        }
+        EXPECT_EQ(steps, moves);
+        EXPECT_TRUE(field.is_goal(row, col));
+      }
+    }
+  }
+}
+
+TEST(DistanceFieldTest, CenterIsTheNearestOfFourCells) {
+  const char *maze_files[] = {"../../mazes/16x16.mz", "../../mazes/hard.mz", "../../mazes/competition_17.mz"};
+  for (auto maze_file : maze_files) {
+    std::ifstream fs;
+    fs.open(maze_file, std::ifstream::in);
+    ASSERT_TRUE(fs.good());
+    AbstractMaze maze(fs);
+
+    // wall the center cells off from each other, so only a flood from all four at once gives each of them 0
+    const unsigned int C = smartmouse::maze::CENTER_CORNER;
+    maze.disconnect_neighbor(C, C, Direction::E);
+    maze.disconnect_neighbor(C, C, Direction::S);
+    maze.disconnect_neighbor(C + 1, C + 1, Direction::N);
+    maze.disconnect_neighbor(C + 1, C + 1, Direction::W);
+
+    DistanceField center;
+    center.compute(maze.walls, C, C, smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
+    DistanceField cells[4];
+    cells[0].compute(maze.walls, C, C);
+    cells[1].compute(maze.walls, C, C + 1);
+    cells[2].compute(maze.walls, C + 1, C);
+    cells[3].compute(maze.walls, C + 1, C + 1);
+
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        uint16_t nearest = DistanceField::UNREACHABLE;
+        for (const DistanceField &cell : cells) {
+          nearest = std::min(nearest, cell.distance(r, c));
+        }
+        ASSERT_EQ(nearest, center.distance(r, c)) << maze_file << " " << r << ", " << c;
+      }
+    }
+
+    // and repairs keep it that way
+    maze.connect_neighbor(C, C, Direction::E);
+    center.wall_removed(maze.walls, C, C, Direction::E);
+    DistanceField fresh;
+    fresh.compute(maze.walls, C, C, smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
+    EXPECT_EQ(0, memcmp(fresh.dist, center.dist, sizeof(fresh.dist)));
+  }
+}
+
+TEST(MazeSnapshotTest, ChangesStayInTheSnapshot) {
+  const MazeWalls base = AbstractMaze::gen_random_legal_walls(5);
+  const MazeWalls before = base;
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  DistanceField base_field;
+  base_field.compute(base, C, C, smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
+
+  srand(0);
+  for (int i = 0; i < 200; i++) {
+    MazeSnapshot snapshot(base);
+    MazeWalls expected = base;
+    for (int j = 0; j < 4; j++) {
+      unsigned int r = rand() % smartmouse::maze::SIZE;
+      unsigned int c = rand() % smartmouse::maze::SIZE;
+      Direction d = static_cast<Direction>(rand() % 4);
+      if (rand() % 2) {
+        snapshot.add_wall(r, c, d);
+        expected.add_wall(r, c, d);
+      } else {
+        snapshot.remove_wall(r, c, d);
+        expected.remove_wall(r, c, d);
+      }
+    }
+    ASSERT_TRUE(snapshot.walls() == expected);
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+        for (Direction d = Direction::First; d < Direction::Last; d++) {
+          ASSERT_EQ(expected.is_wall(r, c, d), snapshot.is_wall(r, c, d));
+        }
+      }
+    }
+
+    DistanceField repaired = base_field;
+    snapshot.repair(&repaired);
+    DistanceField fresh;
+    fresh.compute(expected, C, C, smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
+    ASSERT_EQ(0, memcmp(fresh.dist, repaired.dist, sizeof(fresh.dist))) << "guess " << i;
+
+    snapshot.revert();
+    ASSERT_EQ(0u, snapshot.changed_walls());
+  }
+  EXPECT_TRUE(base == before);
+}
+
+TEST(MazeKnowledgeTest, WallsAreUnknownUntilSensed) {
+  MazeKnowledge knowledge;
+  EXPECT_EQ(WallState::WALL, knowledge.get_state(0, 0, Direction::N));
+  EXPECT_EQ(WallState::WALL, knowledge.get_state(0, 0, Direction::W));
+  EXPECT_EQ(WallState::UNKNOWN, knowledge.get_state(0, 0, Direction::E));
+
+  bool walls[4] = {true, false, true, true};
+  knowledge.update(SensorReading(0, 0, walls));
+  EXPECT_EQ(WallState::OPEN, knowledge.get_state(0, 0, Direction::E));
+  EXPECT_EQ(WallState::OPEN, knowledge.get_state(0, 1, Direction::W));
+  EXPECT_EQ(WallState::WALL, knowledge.get_state(0, 0, Direction::S));
+  EXPECT_EQ(WallState::WALL, knowledge.get_state(1, 0, Direction::N));
+  EXPECT_EQ(WallState::UNKNOWN, knowledge.get_state(0, 1, Direction::E));
+
+  route_t optimistic, pessimistic;
+  EXPECT_TRUE(knowledge.optimistic_route(&optimistic, 0, 0, 0, 2));
+  EXPECT_EQ("2E", route_to_string(optimistic));
+  EXPECT_FALSE(knowledge.pessimistic_route(&pessimistic, 0, 0, 0, 2));
+
+  // a wall we thought was open changes both readings
+  knowledge.mark_wall(0, 0, Direction::E);
+  EXPECT_EQ(WallState::WALL, knowledge.get_state(0, 0, Direction::E));
+  EXPECT_FALSE(knowledge.optimistic_route(&optimistic, 0, 0, 0, 2));
+}
+
+TEST(MazeKnowledgeTest, SensingEverythingMatchesTheTrueMaze) {
+  std::ifstream fs;
+  fs.open("../../mazes/16x16.mz", std::ifstream::in);
+  ASSERT_TRUE(fs.good());
+  AbstractMaze maze(fs);
+
+  MazeKnowledge knowledge;
+  const unsigned int C = smartmouse::maze::CENTER;
+  route_t route;
+  knowledge.optimistic_route(&route, 0, 0, C, C);
+  knowledge.pessimistic_route(&route, 0, 0, C, C);
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    for (unsigned int c = 0; c < smartmouse::maze::SIZE; c++) {
+      bool walls[4];
+      for (Direction d = Direction::First; d < Direction::Last; d++) {
+        walls[static_cast<int>(d)] = maze.walls.is_wall(r, c, d);
+      }
+      knowledge.update(SensorReading(r, c, walls));
+    }
+  }
+
+  EXPECT_EQ(maze.walls, knowledge.optimistic);
+  EXPECT_EQ(maze.walls, knowledge.pessimistic);
+
+  route_t flood_route, optimistic, pessimistic;
+  maze.flood_fill_from_origin_to_center(&flood_route);
+  const unsigned int corner = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  ASSERT_TRUE(knowledge.optimistic_route(&optimistic, 0, 0, corner, corner, N, N));
+  ASSERT_TRUE(knowledge.pessimistic_route(&pessimistic, 0, 0, corner, corner, N, N));
+  EXPECT_EQ(route_to_string(optimistic), route_to_string(pessimistic));
+  EXPECT_EQ(flood_route.size(), optimistic.size());
+}
+
+/** \brief the walls of a maze as the text of a .mz file */
+std::string to_mz(AbstractMaze &maze) {
+  std::string buff;
+  buff.resize(smartmouse::maze::BUFF_SIZE);
+  maze.print_maze_str(&buff[0]);
+  return std::string(buff.c_str());
+}
+
+TEST(MazeFeaturesTest, EmptyAndFullMazes) {
+  MazeWalls empty;
+  empty.remove_all_walls();
+  maze_features_t f = MazeFeatures::analyze(empty);
+  constexpr unsigned int SIZE = smartmouse::maze::SIZE;
+  EXPECT_EQ(0u, f.dead_ends);
+  EXPECT_EQ(2 * SIZE * (SIZE - 1) - (SIZE * SIZE - 1), f.loops);
+  EXPECT_EQ(SIZE, f.longest_straight);
+  EXPECT_EQ(2 * smartmouse::maze::CENTER_CORNER, f.route_length);
+  EXPECT_EQ(1u, f.route_turns);
+  EXPECT_EQ(3432u, f.shortest_routes); // 14 choose 7 ways to make 7 moves south and 7 east
+
+  f = MazeFeatures::analyze(MazeWalls());
+  EXPECT_EQ(0u, f.dead_ends);
+  EXPECT_EQ(0u, f.loops);
+  EXPECT_EQ(1u, f.longest_straight);
+  EXPECT_EQ(0u, f.route_length);
+  EXPECT_EQ(0u, f.shortest_routes);
+}
+
+TEST(MazeFeaturesTest, RouteLengthMatchesFlood) {
+  for (uint32_t i = 0; i < 20; i++) {
+    AbstractMaze maze = AbstractMaze::gen_random_legal_maze(11, i);
+    maze_features_t f = MazeFeatures::analyze(maze);
+
+    route_t path;
+    ASSERT_TRUE(maze.flood_fill_from_origin_to_center(&path));
+    unsigned int length = 0;
+    for (const motion_primitive_t &prim : path) {
+      length += prim.n;
+    }
+    EXPECT_EQ(length, f.route_length);
+    EXPECT_GE(f.shortest_routes, 1u);
+    EXPECT_LE(f.route_turns, path.size() - 1);
+  }
+}
+
+TEST(TimedRoutePlannerTest, CountingCellsMatchesFlood) {
+  const route_timing_t timing = TimedRoutePlanner::cell_count_timing();
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  for (uint32_t i = 0; i < 20; i++) {
+    const MazeWalls walls = AbstractMaze::gen_random_legal_walls(13, i);
+    DistanceField field;
+    field.compute(walls, C, C, N, N);
+
+    route_t path;
+    double seconds;
+    ASSERT_TRUE(TimedRoutePlanner::plan(timing, walls, &path, &seconds, 0, 0, Direction::E, C, C, N, N));
+    EXPECT_EQ(field.distance(0, 0), seconds);
+    EXPECT_EQ(seconds, TimedRoutePlanner::time(timing, path, Direction::E));
+  }
+}
+
+TEST(TimedRoutePlannerTest, FewerTurnsAreFaster) {
+  // in a maze with no walls inside, every route with just one turn is a shortest route and the fastest one
+  AbstractMaze maze;
+  maze.connect_all_neighbors_in_maze();
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  for (bool arc_turns : {false, true}) {
+    const route_timing_t timing = smartmouse::kc::route_timing(arc_turns);
+    route_t path;
+    double seconds;
+    ASSERT_TRUE(TimedRoutePlanner::plan(timing, maze.walls, &path, &seconds, 0, 0, Direction::E, C, C, N, N));
+    ASSERT_EQ(2u, path.size());
+    EXPECT_EQ(Direction::E, path[0].d);
+    EXPECT_EQ(2 * C, static_cast<unsigned int>(path[0].n + path[1].n));
+    EXPECT_NEAR(seconds, TimedRoutePlanner::time(timing, path, Direction::E), 1e-4);
+
+    route_t zig_zag;
+    for (unsigned int i = 0; i < C; i++) {
+      insert_motion_primitive_back(&zig_zag, {1, Direction::E});
+      insert_motion_primitive_back(&zig_zag, {1, Direction::S});
+    }
+    EXPECT_LT(seconds, TimedRoutePlanner::time(timing, zig_zag, Direction::E));
+  }
+
+  // the goal is unreachable when it's walled off
+  for (unsigned int r = C; r < C + N; r++) {
+    maze.disconnect_neighbor(r, C, Direction::W);
+    maze.disconnect_neighbor(r, C + N - 1, Direction::E);
+  }
+  for (unsigned int c = C; c < C + N; c++) {
+    maze.disconnect_neighbor(C, c, Direction::N);
+    maze.disconnect_neighbor(C + N - 1, c, Direction::S);
+  }
+  route_t path;
+  EXPECT_FALSE(TimedRoutePlanner::plan(smartmouse::kc::route_timing(false), maze.walls, &path, nullptr, 0, 0,
+                                       Direction::E, C, C, N, N));
+  EXPECT_TRUE(path.empty());
+}
+
+TEST(DiagonalPlannerTest, StaircasesAreCutAcross) {
+  AbstractMaze maze;
+  maze.connect_all_neighbors_in_maze();
+  route_t stairs;
+  insert_motion_primitive_back(&stairs, {2, Direction::E});
+  for (unsigned int i = 0; i < 3; i++) {
+    insert_motion_primitive_back(&stairs, {1, Direction::S});
+    insert_motion_primitive_back(&stairs, {1, Direction::E});
+  }
+  insert_motion_primitive_back(&stairs, {2, Direction::E});
+
+  // the cells from the first turn to the last one are cut, entering and leaving on the middles of their edges
+  diagonal_route_t diagonal;
+  const double clearance = smartmouse::kc::TRACK_WIDTH_CU / 2;
+  EXPECT_EQ(1u, DiagonalPlanner::plan(maze.walls, stairs, 0, 0, clearance, &diagonal));
+  EXPECT_EQ("3E6SE5E", diagonal_route_to_string(diagonal));
+  for (bool arc_turns : {false, true}) {
+    EXPECT_LT(smartmouse::kc::diagonal_route_seconds(diagonal, Direction::E, arc_turns),
+              TimedRoutePlanner::time(smartmouse::kc::route_timing(arc_turns), stairs, Direction::E));
+  }
+
+  // a mouse too wide to fit between the posts keeps turning in every cell
+  EXPECT_EQ(0u, DiagonalPlanner::plan(maze.walls, stairs, 0, 0, 0.4, &diagonal));
+  EXPECT_EQ("4E2S2E2S2E2S6E", diagonal_route_to_string(diagonal));
+
+  // posts are always closer to a diagonal than the walls between them, unless the diagonal goes through a wall
+  EXPECT_TRUE(DiagonalPlanner::clears_walls(maze.walls, 0.5, 2, 3.5, 5, clearance));
+  maze.disconnect_neighbor(1, 3, Direction::S);
+  EXPECT_FALSE(DiagonalPlanner::clears_walls(maze.walls, 0.5, 2, 3.5, 5, clearance));
+}
+
+TEST(DiagonalPlannerTest, SecondsWithoutDiagonalsMatchTimedRoutes) {
+  for (uint32_t i = 0; i < 10; i++) {
+    const MazeWalls walls = AbstractMaze::gen_random_legal_walls(13, i);
+    DistanceField field;
+    field.compute(walls, smartmouse::maze::CENTER_CORNER, smartmouse::maze::CENTER_CORNER,
+                  smartmouse::maze::CENTER_CELLS, smartmouse::maze::CENTER_CELLS);
+    route_t route;
+    ASSERT_TRUE(field.route(walls, &route, 0, 0));
+
+    diagonal_route_t orthogonal;
+    EXPECT_EQ(0u, DiagonalPlanner::plan(walls, route, 0, 0, 0, &orthogonal, smartmouse::maze::SIZE * 2));
+    for (bool arc_turns : {false, true}) {
+      EXPECT_NEAR(TimedRoutePlanner::time(smartmouse::kc::route_timing(arc_turns), route, Direction::N),
+                  smartmouse::kc::diagonal_route_seconds(orthogonal, Direction::N, arc_turns), 1e-9);
+    }
+  }
+}
+
+TEST(MazeParserTest, ConcatenatedMazesWithCRLF) {
+  std::vector<MazeWalls> expected = MazeParser::parse_file("../../mazes/16x16.mz");
+  ASSERT_EQ(1u, expected.size());
+  AbstractMaze random = AbstractMaze::gen_random_legal_maze();
+  expected.push_back(random.walls);
+
+  AbstractMaze first;
+  first.set_walls(expected[0]);
+  std::string text = "a comment before the first maze\n\n" + to_mz(first) + "best answer so far:\n" + to_mz(random);
+  std::string crlf;
+  for (char c : text) {
+    if (c == '\n') {
+      crlf += '\r';
+    }
+    crlf += c;
+  }
+
+  for (const std::string &buffer : {text, crlf}) {
+    MazeParser parser(buffer.data(), buffer.size());
+    MazeWalls walls;
+    for (const MazeWalls &maze : expected) {
+      ASSERT_TRUE(parser.next(&walls));
+      EXPECT_EQ(maze, walls);
+    }
+    EXPECT_FALSE(parser.next(&walls));
+  }
+}
+
+TEST(MazeParserTest, ErrorsSayWhere) {
+  auto error_at = [](const std::string &text, unsigned int line, unsigned int column) {
+    MazeParser parser(text.data(), text.size(), "test.mz");
+    MazeWalls walls;
+    try {
+      parser.next(&walls);
+      ADD_FAILURE() << "no error for " << text;
+    }
+    catch (MazeParseError &e) {
+      EXPECT_EQ("test.mz", e.file);
+      EXPECT_EQ(line, e.line) << e.what();
+      EXPECT_EQ(column, e.column) << e.what();
+    }
+  };
+
+  AbstractMaze maze;
+  maze.connect_all_neighbors_in_maze();
+  const std::string good = to_mz(maze);
+  const size_t row_length = 2 * smartmouse::maze::SIZE + 2;
+
+  // a 12x12 maze is too narrow
+  std::ifstream fs("../../mazes/jank.mz");
+  const std::string jank((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+  error_at(jank, 1, 26);
+
+  // cut off after 5 rows
+  error_at(good.substr(0, 5 * row_length), 6, 1);
+
+  // a character that isn't a wall or a space
+  std::string bad = good;
+  bad[2 * row_length + 3] = 'x';
+  error_at(bad, 3, 4);
+
+  // a hole in the south side
+  bad = good;
+  bad[(smartmouse::maze::SIZE - 1) * row_length + 5] = ' ';
+  error_at(bad, smartmouse::maze::SIZE, 6);
+
+  // and in the east side
+  bad = "comment\n" + good;
+  bad[8 + row_length - 2] = ' ';
+  error_at(bad, 2, 2 * smartmouse::maze::SIZE + 1);
+
+  std::ifstream empty_fs("../../mazes/not_a_maze.mz");
+  EXPECT_THROW(AbstractMaze empty(empty_fs), MazeParseError);
+}
+
+TEST(MazeCorpusTest, MazesSurviveTheRoundTrip) {
+  const char *maze_files[] = {"../../mazes/16x16.mz", "../../mazes/hard.mz", "../../mazes/empty.mz"};
+  MazeCorpusWriter writer;
+  for (auto maze_file : maze_files) {
+    ASSERT_TRUE(writer.add_mz(maze_file));
+  }
+  AbstractMaze random = AbstractMaze::gen_random_legal_maze();
+  writer.add(random.walls, "", "random");
+  EXPECT_FALSE(writer.add_mz("../../mazes/not_a_maze.mz"));
+  ASSERT_TRUE(writer.save("round_trip.mzc"));
+
+  MazeCorpusReader reader;
+  ASSERT_TRUE(reader.open("round_trip.mzc"));
+  ASSERT_EQ(4u, reader.count());
+  for (unsigned int i = 0; i < 3; i++) {
+    std::ifstream fs;
+    fs.open(maze_files[i], std::ifstream::in);
+    AbstractMaze maze(fs);
+    EXPECT_EQ(maze.walls, reader.walls(i));
+    EXPECT_EQ(maze_files[i], reader.name(i));
+    EXPECT_EQ("", reader.metadata(i));
+
+    // and back to text, which has to read in as the same maze
+    std::ofstream out("round_trip.mz");
+    out << reader.mz(i);
+    out.close();
+    std::ifstream in("round_trip.mz");
+    EXPECT_EQ(maze.walls, AbstractMaze(in).walls);
+  }
+  EXPECT_EQ(random.walls, reader.walls(3));
+  EXPECT_EQ("", reader.name(3));
+  EXPECT_EQ("random", reader.metadata(3));
+  reader.close();
+
+  // a file that isn't a corpus is refused
+  EXPECT_FALSE(reader.open("../../mazes/16x16.mz"));
+  EXPECT_EQ(0u, reader.count());
+  remove("round_trip.mzc");
+  remove("round_trip.mz");
+}
+
+TEST(RouteCacheTest, IncrementalHashMatchesRecompute) {
+  srand(0);
+  AbstractMaze maze;
+  for (int i = 0; i < 2000; i++) {
+    unsigned int r = rand() % smartmouse::maze::SIZE;
+    unsigned int c = rand() % smartmouse::maze::SIZE;
+    Direction d = static_cast<Direction>(rand() % 4);
+    if (rand() % 2) {
+      maze.disconnect_neighbor(r, c, d);
+    } else {
+      maze.connect_neighbor(r, c, d);
+    }
+    ASSERT_EQ(maze.walls.zobrist_hash(), maze.hash) << "after change " << i;
+  }
+
+  AbstractMaze all_walls;
+  maze.set_walls(all_walls.walls);
+  EXPECT_EQ(all_walls.hash, maze.hash);
+}
+
+TEST(RouteCacheTest, SameWallsReuseTheRoute) {
+  std::ifstream fs;
+  fs.open("../../mazes/16x16.mz", std::ifstream::in);
+  ASSERT_TRUE(fs.good());
+  AbstractMaze maze(fs);
+  RouteCache cache;
+  maze.route_cache = &cache;
+
+  const unsigned int C = smartmouse::maze::CENTER;
+  route_t first, second;
+  ASSERT_TRUE(maze.flood_fill_from_origin_to_center(&first));
+  ASSERT_TRUE(maze.flood_fill_from_origin_to_center(&second));
+  EXPECT_EQ(1ul, cache.hits);
+  EXPECT_EQ(1ul, cache.misses);
+  EXPECT_EQ(route_to_string(first), route_to_string(second));
+
+  // knocking a wall down and putting it back gives the same hash, so it's still a hit
+  Direction d = maze.walls.is_wall(C, C, Direction::S) ? Direction::S : Direction::E;
+  bool was_wall = maze.walls.is_wall(C, C, d);
+  if (was_wall) {
+    maze.connect_neighbor(C, C, d);
+  } else {
+    maze.disconnect_neighbor(C, C, d);
+  }
+  maze.flood_fill_from_origin_to_center(&second);
+  EXPECT_EQ(2ul, cache.misses);
+  if (was_wall) {
+    maze.disconnect_neighbor(C, C, d);
+  } else {
+    maze.connect_neighbor(C, C, d);
+  }
+  maze.flood_fill_from_origin_to_center(&second);
+  EXPECT_EQ(2ul, cache.hits);
+  EXPECT_EQ(route_to_string(first), route_to_string(second));
+}
+
 TEST(SolveMazeTest, WallFollowSolve) {
   std::string maze_file = "../../mazes/16x16.mz";
   std::ifstream fs;
@@ -258,6 +982,226 @@ TEST(SolveMazeTest, RandSolve) {
   }
 }
 
+TEST(SolveMazeTest, AStarSolve) {
+  for (uint32_t i = 0; i < 20; i++) {
+    AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, i);
+    ConsoleMouse::inst()->seedMaze(&maze);
+
+    AStar solver(ConsoleMouse::inst());
+    solver.setup();
+    route_t solution = solver.solve();
+    solver.teardown();
+
+    ASSERT_TRUE(solver.isSolvable());
+    EXPECT_TRUE(solver.isFinished());
+    EXPECT_FALSE(solution.empty());
+  }
+}
+
+TEST(SolveMazeTest, DStarLiteSolve) {
+  for (uint32_t i = 0; i < 20; i++) {
+    AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, i);
+    ConsoleMouse *mouse = ConsoleMouse::inst();
+    mouse->seedMaze(&maze);
+
+    DStarLite solver(mouse);
+    solver.setup();
+    MazeKnowledge knowledge;
+    unsigned int steps = 0;
+    for (Solver::Goal goal : {Solver::Goal::CENTER, Solver::Goal::START}) {
+      solver.setGoal(goal);
+      const unsigned int goal_corner = goal == Solver::Goal::CENTER ? smartmouse::maze::CENTER_CORNER : 0;
+      const unsigned int goal_size = goal == Solver::Goal::CENTER ? smartmouse::maze::CENTER_CELLS : 1;
+      while (!solver.isFinished() && steps++ < 1000) {
+        // the repaired route has to be as short as one planned from scratch with the same walls
+        knowledge.update(mouse->checkWalls());
+        route_t expected;
+        ASSERT_TRUE(knowledge.optimistic_route(&expected, mouse->getRow(), mouse->getCol(), goal_corner, goal_corner,
+                                               goal_size, goal_size));
+
+        const motion_primitive_t prim = solver.planNextStep();
+        const route_t &path = mouse->maze->path_to_next_goal;
+        unsigned int expected_cells = 0;
+        unsigned int cells = 0;
+        for (const motion_primitive_t &p : expected) {
+          expected_cells += p.n;
+        }
+        for (const motion_primitive_t &p : path) {
+          cells += p.n;
+        }
+        ASSERT_EQ(expected_cells, cells);
+
+        mouse->internalTurnToFace(prim.d);
+        mouse->internalForward();
+      }
+      ASSERT_TRUE(solver.isSolvable());
+    }
+    EXPECT_EQ(0u, mouse->getRow());
+    EXPECT_EQ(0u, mouse->getCol());
+  }
+}
+
+TEST(SolveMazeTest, DStarLiteReopensWalls) {
+  AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, 0);
+  ConsoleMouse *mouse = ConsoleMouse::inst();
+  mouse->seedMaze(&maze);
+
+  // a noisy first reading sees walls on every way out of the start, and the next reading sees they're open after all
+  std::vector<Direction> exits;
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    if (!maze.walls.is_wall(0, 0, d)) {
+      exits.push_back(d);
+      maze.disconnect_neighbor(0, 0, d);
+    }
+  }
+  ASSERT_FALSE(exits.empty());
+
+  DStarLite solver(mouse);
+  solver.setup();
+  solver.planNextStep();
+  EXPECT_FALSE(solver.isSolvable());
+
+  for (Direction d : exits) {
+    maze.connect_neighbor(0, 0, d);
+  }
+  const motion_primitive_t prim = solver.planNextStep();
+  EXPECT_TRUE(solver.isSolvable());
+  EXPECT_NE(Direction::INVALID, prim.d);
+}
+
+TEST(SolverRegistryTest, ChooseByNameAndSetParams) {
+  solver_choice_t choice;
+  ASSERT_FALSE(SolverRegistry::choose("dijkstra", &choice));
+  ASSERT_TRUE(SolverRegistry::choose("astar", &choice));
+  EXPECT_STREQ("astar", SolverRegistry::entry(choice.index).name);
+  EXPECT_EQ(1, choice.params[1]);
+
+  EXPECT_TRUE(SolverRegistry::set_param(&choice, "weight=1.5"));
+  EXPECT_EQ(1.5, choice.params[1]);
+  EXPECT_FALSE(SolverRegistry::set_param(&choice, "weight"));
+  EXPECT_FALSE(SolverRegistry::set_param(&choice, "weight=fast"));
+  EXPECT_FALSE(SolverRegistry::set_param(&choice, "weigh=2"));
+  EXPECT_FALSE(SolverRegistry::set_param(&choice, "weights=2"));
+  EXPECT_EQ(1.5, choice.params[1]);
+
+  ASSERT_TRUE(SolverRegistry::choose("wallfollow", &choice));
+  EXPECT_FALSE(SolverRegistry::set_param(&choice, "timed=0"));
+}
+
+TEST(SolverRegistryTest, EverySolverExplores) {
+  AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, 3);
+  ConsoleMouse *mouse = ConsoleMouse::inst();
+  const route_timing_t timing = smartmouse::kc::route_timing(true);
+  for (unsigned int i = 0; i < SolverRegistry::count(); i++) {
+    // following the left wall never gets to the center
+    if (strcmp(SolverRegistry::entry(i).name, "wallfollow") == 0) {
+      continue;
+    }
+    mouse->seedMaze(&maze);
+    Solver *solver = SolverRegistry::create(SolverRegistry::choose(i), mouse, &timing);
+    solver->setup();
+    const route_t solution = solver->solve();
+    solver->teardown();
+    EXPECT_TRUE(solver->isSolvable()) << SolverRegistry::entry(i).name;
+    EXPECT_FALSE(solution.empty()) << SolverRegistry::entry(i).name;
+    EXPECT_FALSE(mouse->maze->fastest_route.empty()) << SolverRegistry::entry(i).name;
+    delete solver;
+  }
+}
+
+TEST(SolverRegistryTest, SelectedSolverSwitches) {
+  AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, 5);
+  ConsoleMouse *mouse = ConsoleMouse::inst();
+  mouse->seedMaze(&maze);
+
+  solver_choice_t choice;
+  ASSERT_TRUE(SolverRegistry::choose("dstarlite", &choice));
+  SelectedSolver solver(mouse, nullptr);
+  EXPECT_EQ(0u, solver.selected());
+  solver.setup();
+  solver.select(choice.index);
+  EXPECT_EQ(choice.index, solver.selected());
+  solver.select(SolverRegistry::count());
+  EXPECT_EQ(choice.index, solver.selected());
+
+  solver.setGoal(Solver::Goal::CENTER);
+  solver.solve();
+  solver.teardown();
+  EXPECT_TRUE(solver.isSolvable());
+  EXPECT_FALSE(mouse->maze->fastest_route.empty());
+}
+
+TEST(AStarTest, SearchMatchesFlood) {
+  const unsigned int C = smartmouse::maze::CENTER_CORNER;
+  const unsigned int N = smartmouse::maze::CENTER_CELLS;
+  AStar solver(ConsoleMouse::inst());
+  for (uint32_t i = 0; i < 20; i++) {
+    const MazeWalls walls = AbstractMaze::gen_random_legal_walls(13, i);
+    DistanceField field;
+    field.compute(walls, C, C, N, N);
+
+    route_t path;
+    ASSERT_TRUE(solver.search(walls, &path, i % smartmouse::maze::SIZE, 0, C, C, N, N));
+    unsigned int cells = 0;
+    for (const motion_primitive_t &prim : path) {
+      cells += prim.n;
+    }
+    EXPECT_EQ(field.distance(i % smartmouse::maze::SIZE, 0), cells);
+    EXPECT_LE(solver.nodes_expanded, smartmouse::maze::SIZE * smartmouse::maze::SIZE);
+  }
+
+  // with nothing in the way, only the cells on one shortest route are looked at
+  AbstractMaze open;
+  open.connect_all_neighbors_in_maze();
+  route_t path;
+  ASSERT_TRUE(solver.search(open.walls, &path, 0, 0, C, C, N, N));
+  EXPECT_EQ(2 * C + 1, solver.nodes_expanded);
+}
+
+TEST(SolveMazeTest, SeededMazesAreRepeatable) {
+  for (uint32_t i = 0; i < 100; i++) {
+    AbstractMaze maze = AbstractMaze::gen_random_legal_maze(7, i);
+    EXPECT_TRUE(maze == AbstractMaze::gen_random_legal_maze(7, i));
+    EXPECT_FALSE(maze == AbstractMaze::gen_random_legal_maze(7, i + 1));
+
+    route_t path;
+    ASSERT_TRUE(maze.flood_fill(&path, 0, 0, smartmouse::maze::CENTER, smartmouse::maze::CENTER));
+  }
+
+  // the standard fixes what mt19937 makes, so this is the same maze on every platform
+  EXPECT_EQ(9574604020000548474ull, AbstractMaze::gen_random_legal_walls(7).zobrist_hash());
+}
+
+TEST(MazeRendererTest, OnlyChangesAreRedrawn) {
+  FILE *out = tmpfile();
+  ASSERT_NE(nullptr, out);
+  ConsoleMouse *mouse = ConsoleMouse::inst();
+  mouse->reset();
+  mouse->maze->set_walls(AbstractMaze::gen_random_legal_walls(7));
+  MazeRenderer renderer(out, MazeRenderer::PATH | MazeRenderer::WEIGHTS | MazeRenderer::VISITED);
+
+  renderer.render(*mouse);
+  const size_t full = renderer.lastFrameBytes();
+  renderer.render(*mouse);
+  EXPECT_EQ(0u, renderer.lastFrameBytes());
+
+  // turning only changes the arrow
+  mouse->internalTurnToFace(Direction::S);
+  renderer.render(*mouse);
+  EXPECT_GT(renderer.lastFrameBytes(), 0u);
+  EXPECT_LT(renderer.lastFrameBytes() * 20, full);
+
+  renderer.invalidate();
+  renderer.render(*mouse);
+  EXPECT_EQ(full, renderer.lastFrameBytes());
+  fclose(out);
+
+  unsigned int overlays;
+  EXPECT_TRUE(MazeRenderer::parseOverlays("path,visited", &overlays));
+  EXPECT_EQ(MazeRenderer::PATH | MazeRenderer::VISITED, overlays);
+  EXPECT_FALSE(MazeRenderer::parseOverlays("path,walls", &overlays));
+}
+
 TEST(DirectionTest, DirectionLogic) {
   EXPECT_TRUE(Direction::W > Direction::S);
   EXPECT_TRUE(Direction::W > Direction::E);
@@ -272,6 +1216,34 @@ TEST(DirectionTest, DirectionLogic) {
   EXPECT_TRUE(Direction::E < Direction::S);
 }
 
+TEST(DirectionTest, TablesAreConstexpr) {
+  static_assert(left_of_dir(Direction::N) == Direction::W, "left of N");
+  static_assert(right_of_dir(Direction::W) == Direction::N, "right of W");
+  static_assert(opposite_direction(Direction::E) == Direction::W, "opposite of E");
+  static_assert(opposite_direction('S') == 'N', "opposite of 'S'");
+  static_assert(dir_row_delta(Direction::N) == -1 && dir_col_delta(Direction::N) == 0, "N goes up a row");
+  static_assert(dir_row_delta(Direction::E) == 0 && dir_col_delta(Direction::E) == 1, "E goes right a column");
+  static_assert(smartmouse::maze::index_delta(Direction::S) == smartmouse::maze::SIZE, "S goes down a row");
+  static_assert(dir_to_char(char_to_dir('W')) == 'W', "W round trips");
+
+  for (Direction d = Direction::First; d < Direction::Last; d++) {
+    EXPECT_EQ(d, left_of_dir(right_of_dir(d)));
+    EXPECT_EQ(d, opposite_direction(opposite_direction(d)));
+    EXPECT_EQ(d, yaw_to_dir(dir_to_yaw(d)));
+    EXPECT_EQ(0, dir_row_delta(d) + dir_row_delta(opposite_direction(d)));
+    EXPECT_EQ(0, dir_col_delta(d) + dir_col_delta(opposite_direction(d)));
+  }
+
+  EXPECT_EQ(Direction::INVALID, left_of_dir(Direction::INVALID));
+  EXPECT_EQ(Direction::INVALID, opposite_direction(Direction::Last));
+  EXPECT_EQ('\0', dir_to_char(Direction::INVALID));
+  EXPECT_EQ(0, dir_row_delta(Direction::INVALID));
+
+  Direction d = Direction::Last;
+  d--;
+  EXPECT_EQ(Direction::W, d);
+}
+
 TEST(RouteUtilTest, RouteUtilAddBack) {
   route_t route;
   insert_motion_primitive_back(&route, {1, Direction::N});
@@ -308,6 +1280,19 @@ TEST(RouteUtilTest, RouteUtilAddFront) {
   EXPECT_STREQ(route_to_string(route).c_str(), "1E1S3E3N");
 }
 
+TEST(RouteUtilTest, RouteDropsMovesThatDontFit) {
+  route_t route;
+  for (unsigned int i = 0; i < route_t::capacity() + 10; i++) {
+    insert_motion_primitive_back(&route, {1, i % 2 ? Direction::N : Direction::E});
+  }
+  EXPECT_EQ(route_t::capacity(), route.size());
+
+  // merging with the end that's already there still works when it's full
+  insert_motion_primitive_front(&route, {1, Direction::E});
+  EXPECT_EQ(2, route.front().n);
+  EXPECT_EQ(route_t::capacity(), route.size());
+}
+
 TEST(RouteStringTest, RouteStringText) {
   route_t route = {{1, Direction::N}, {2, Direction::W}, {3, Direction::E}, {1, Direction::S}};
   std::string s = route_to_string(route);
@@ -3,8 +3,9 @@
 #include "Calibrate.h"
 
 bool WaitForStart::calibrated = false;
+SelectedSolver *WaitForStart::solvers = nullptr;
 
-WaitForStart::WaitForStart() : CommandGroup("wait_calibrate"), mouse(RealMouse::inst()), speed(0) {
+WaitForStart::WaitForStart() : CommandGroup("wait_calibrate"), mouse(RealMouse::inst()), speed(0), solver_index(0) {
   mouse->kinematic_controller.enabled = false;
   if (!calibrated) {
     addSequential(new Calibrate());
@@ -15,6 +16,9 @@ WaitForStart::WaitForStart() : CommandGroup("wait_calibrate"), mouse(RealMouse::
 void WaitForStart::initialize() {
   init_ticks_left = mouse->left_encoder.read();
   init_ticks_right = mouse->right_encoder.read();
+  if (solvers) {
+    solver_index = solvers->selected();
+  }
 }
 
 void WaitForStart::execute() {
@@ -24,8 +28,9 @@ void WaitForStart::execute() {
   double percent_speed = fmod(mouse->left_encoder.read() - init_ticks_left, 1024) / 1024;
   speed =  percent_speed * smartmouse::kc::MAX_HARDWARE_SPEED_MPS;
 
-  int idx = percent_speed * 100 / 7;
-  for (int i = 0; i < 7; i++) {
+  // LED_1 and LED_2 show the solver, so the speed bar is the other five
+  int idx = percent_speed * 5;
+  for (int i = 0; i < 5; i++) {
     if (i < idx) {
       digitalWrite(RealMouse::LED_7 - i, 1);
     } else {
@@ -33,13 +38,21 @@ void WaitForStart::execute() {
     }
   }
 
-  // Set arc turn on or off based on left wheel
-  smartmouse::kc::ARC_TURN = fmod(fabs(mouse->right_encoder.read() - init_ticks_right), 200) > 100;
+  // The right wheel steps through arc turns off and on, then on to the next solver
+  const unsigned int slot = fabs(mouse->right_encoder.read() - init_ticks_right) / 100;
+  smartmouse::kc::ARC_TURN = slot % 2 == 1;
   if (smartmouse::kc::ARC_TURN) {
     digitalWrite(RealMouse::LED_8, 1);
   } else {
     digitalWrite(RealMouse::LED_8, 0);
   }
+
+  // counted on from the solver already selected, so leaving the wheel alone between runs keeps what was learned
+  if (solvers) {
+    solver_index = (solvers->selected() + slot / 2) % SolverRegistry::count();
+    digitalWrite(RealMouse::LED_1, solver_index & 1);
+    digitalWrite(RealMouse::LED_2, (solver_index >> 1) & 1);
+  }
 }
 
 bool WaitForStart::isFinished() {
@@ -56,6 +69,9 @@ void WaitForStart::end() {
   for (int i = 0; i < 7; i++) {
     digitalWrite(RealMouse::LED_7 - i, 0);
   }
+  if (solvers) {
+    solvers->select(solver_index);
+  }
   mouse->resetToStartPose();
   mouse->kinematic_controller.enabled = true;
 }
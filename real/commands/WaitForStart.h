@@ -1,6 +1,7 @@
 #pragma once
 
 #include <common/commanduino/CommanDuino.h>
+#include <common/core/SolverRegistry.h>
 #include "RealMouse.h"
 
 class WaitForStart : public CommandGroup {
@@ -11,8 +12,12 @@ public:
   bool isFinished();
   void end();
 
+  /** \brief if it's set, the right wheel also picks which of these solvers to run */
+  static SelectedSolver *solvers;
+
 private:
   double speed;
+  unsigned int solver_index;
   int init_ticks_left;
   int init_ticks_right;
   static bool calibrated;
@@ -3,8 +3,9 @@
 #include <real/ArduinoTimer.h>
 #include <real/RealMouse.h>
 #include <common/core/util.h>
-#include <common/core/Flood.h>
+#include <common/core/SolverRegistry.h>
 #include <common/commands/SolveCommand.h>
+#include <commands/WaitForStart.h>
 
 ArduinoTimer timer;
 AbstractMaze maze;
@@ -24,7 +25,10 @@ void setup() {
   GlobalProgramSettings.quiet = false;
 
 //  scheduler = new Scheduler(new NavTestCommand());
-  scheduler = new Scheduler(new SolveCommand(new Flood(mouse)));
+  // picked from the menu in WaitForStart, and flood until then
+  SelectedSolver *solvers = new SelectedSolver(mouse, nullptr);
+  WaitForStart::solvers = solvers;
+  scheduler = new Scheduler(new SolveCommand(solvers));
 
   last_t = timer.programTimeMs();
   last_blink = timer.programTimeMs();
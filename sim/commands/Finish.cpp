@@ -5,7 +5,7 @@ Finish::Finish(AbstractMaze *maze) : Command("end"), maze(maze) {}
 
 void Finish::initialize() {
   SimMouse::inst()->setSpeedCps(0, 0);
-  print("end. Solution = %s\n", maze->fastest_route);
+  print("end. Solution = %s\n", route_to_string(maze->fastest_route).c_str());
 }
 
 bool Finish::isFinished() {
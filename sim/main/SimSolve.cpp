@@ -1,18 +1,38 @@
 #include <common/commanduino/CommanDuino.h>
 #include <common/commands/SolveCommand.h>
-#include <common/core/Flood.h>
+#include <common/core/SolverRegistry.h>
+#include <common/KinematicController/RouteTiming.h>
 
 #include <sim/lib/SimTimer.h>
 #include <sim/lib/SimMouse.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char *argv[]) {
+  solver_choice_t choice;
+  SolverRegistry::choose("flood", &choice);
+  for (int i = 1; i < argc; i += 2) {
+    if (i + 1 < argc && strcmp(argv[i], "--solver") == 0 && SolverRegistry::choose(argv[i + 1], &choice)) {
+      continue;
+    }
+    // the solver has to come before its parameters here, since they're set as they're read
+    if (i + 1 < argc && strcmp(argv[i], "--param") == 0 && SolverRegistry::set_param(&choice, argv[i + 1])) {
+      continue;
+    }
+    printf("USAGE: SimSolve [--solver NAME] [--param K=V ...]\n%s", SolverRegistry::describe().c_str());
+    return EXIT_FAILURE;
+  }
+
   SimMouse *mouse = SimMouse::inst();
 
   mouse->simInit();
 
   GlobalProgramSettings.quiet = true;
 
-  Scheduler scheduler(new SolveCommand(new Flood(mouse)));
+  const route_timing_t timing = smartmouse::kc::route_timing(smartmouse::kc::ARC_TURN);
+  Solver *solver = SolverRegistry::create(choice, mouse, &timing);
+  Scheduler scheduler(new SolveCommand(solver));
 
   bool done = false;
   unsigned long last_t = mouse->timer->programTimeMs();
@@ -19,7 +19,7 @@ Client::Client(QMainWindow *parent) :
 
   server_control_pub_ = node_.Advertise<smartmouse::msgs::ServerControl>(TopicNames::kServerControl);
   physics_pub_ = node_.Advertise<smartmouse::msgs::PhysicsConfig>(TopicNames::kPhysics);
-  maze_pub_ = node_.Advertise<smartmouse::msgs::Maze>(TopicNames::kMaze);
+  maze_pub_ = node_.Advertise<smartmouse::msgs::MazeDelta>(TopicNames::kMaze);
   robot_description_pub_ = node_.Advertise<smartmouse::msgs::RobotDescription>(TopicNames::kRobotDescription);
   robot_command_pub_ = node_.Advertise<smartmouse::msgs::RobotCommand>(TopicNames::kRobotCommand);
   pid_setpoints_pub_ = node_.Advertise<ignition::msgs::Vector2d>(TopicNames::kPIDSetpoints);
@@ -195,16 +195,14 @@ void Client::LoadNewMaze() {
     std::ifstream fs;
     fs.open(file_info.absoluteFilePath().toStdString(), std::fstream::in);
     AbstractMaze maze(fs);
-    smartmouse::msgs::Maze maze_msg = smartmouse::msgs::Convert(&maze);
-    maze_pub_.Publish(maze_msg);
+    maze_pub_.Publish(maze_encoder_.Encode(maze.walls, true));
     ui_->maze_file_name_label->setText(file_info.fileName());
   }
 }
 
 void Client::LoadRandomMaze() {
   AbstractMaze maze = AbstractMaze::gen_random_legal_maze();
-  smartmouse::msgs::Maze maze_msg = smartmouse::msgs::Convert(&maze);
-  maze_pub_.Publish(maze_msg);
+  maze_pub_.Publish(maze_encoder_.Encode(maze.walls, true));
 }
 
 void Client::LoadDefaultMouse() {
@@ -236,8 +234,7 @@ void Client::LoadDefaultMaze() {
     fs.open(maze_filename, std::fstream::in);
     if (fs.good()) {
       AbstractMaze maze(fs);
-      smartmouse::msgs::Maze maze_msg = smartmouse::msgs::Convert(&maze);
-      maze_pub_.Publish(maze_msg);
+      maze_pub_.Publish(maze_encoder_.Encode(maze.walls, true));
       ui_->maze_file_name_label->setText(file_info.fileName());
     } else {
       std::cout << "default mouse file [" << maze_filename << "] not found. Loading random maze.\n";
@@ -75,6 +75,7 @@ class Client : public QMainWindow {
   sole::uuid uuid;
   ignition::transport::Node node_;
   ignition::transport::Node::Publisher maze_pub_;
+  smartmouse::msgs::MazeDeltaEncoder maze_encoder_;
   ignition::transport::Node::Publisher physics_pub_;
   ignition::transport::Node::Publisher server_control_pub_;
   ignition::transport::Node::Publisher robot_command_pub_;
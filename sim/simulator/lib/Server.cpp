@@ -334,11 +334,16 @@ void Server::OnPhysics(const smartmouse::msgs::PhysicsConfig &msg) {
   // End critical section
 }
 
-void Server::OnMaze(const smartmouse::msgs::Maze &msg) {
+void Server::OnMaze(const smartmouse::msgs::MazeDelta &msg) {
   // Enter critical section
   {
 //    std::lock_guard<std::mutex> guard(physics_mutex_);
-    smartmouse::msgs::Convert(msg, maze_walls_);
+    // only the cells with walls that changed get their lines rebuilt
+    const MazeWalls previous = maze_decoder_.Walls();
+    const bool had_maze = maze_decoder_.Synced();
+    if (maze_decoder_.Apply(msg)) {
+      smartmouse::msgs::Convert(maze_decoder_.Walls(), had_maze ? &previous : nullptr, maze_walls_);
+    }
   }
   // End critical section
 }
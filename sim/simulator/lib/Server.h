@@ -32,7 +32,7 @@ class Server {
  private:
   void OnServerControl(const smartmouse::msgs::ServerControl &msg);
   void OnPhysics(const smartmouse::msgs::PhysicsConfig &msg);
-  void OnMaze(const smartmouse::msgs::Maze &msg);
+  void OnMaze(const smartmouse::msgs::MazeDelta &msg);
   void OnRobotCommand(const smartmouse::msgs::RobotCommand &msg);
   void OnRobotDescription(const smartmouse::msgs::RobotDescription &msg);
 
@@ -60,6 +60,7 @@ class Server {
   unsigned int ns_of_sim_per_step_ = 1000000u;
   unsigned long pause_at_steps_ = 0ul;
   double real_time_factor_ = 1.0;
+  smartmouse::msgs::MazeDeltaDecoder maze_decoder_;
   smartmouse::msgs::maze_walls_t maze_walls_;
   smartmouse::msgs::RobotCommand cmd_;
   smartmouse::msgs::RobotDescription mouse_;
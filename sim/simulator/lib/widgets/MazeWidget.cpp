@@ -144,9 +144,13 @@ const QString MazeWidget::GetTabName() {
   return QString("Maze View");
 }
 
-void MazeWidget::OnMaze(const smartmouse::msgs::Maze &msg) {
-  smartmouse::msgs::Convert(msg, maze_walls_);
-  emit MyUpdate();
+void MazeWidget::OnMaze(const smartmouse::msgs::MazeDelta &msg) {
+  const MazeWalls previous = maze_decoder_.Walls();
+  const bool had_maze = maze_decoder_.Synced();
+  if (maze_decoder_.Apply(msg)) {
+    smartmouse::msgs::Convert(maze_decoder_.Walls(), had_maze ? &previous : nullptr, maze_walls_);
+    emit MyUpdate();
+  }
 }
 
 void MazeWidget::OnRobotDescription(const smartmouse::msgs::RobotDescription &msg) {
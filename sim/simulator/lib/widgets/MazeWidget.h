@@ -18,7 +18,7 @@ class MazeWidget : public QWidget, public AbstractTab {
  public:
   MazeWidget();
 
-  void OnMaze(const smartmouse::msgs::Maze &msg);
+  void OnMaze(const smartmouse::msgs::MazeDelta &msg);
   void OnRobotDescription(const smartmouse::msgs::RobotDescription &msg);
   void OnRobotSimState(const smartmouse::msgs::RobotSimState &msg);
 
@@ -41,6 +41,7 @@ class MazeWidget : public QWidget, public AbstractTab {
   static QBrush kWallBrush;
 
   ignition::transport::Node node_;
+  smartmouse::msgs::MazeDeltaDecoder maze_decoder_;
   smartmouse::msgs::maze_walls_t maze_walls_;
   smartmouse::msgs::RobotSimState robot_state_;
   smartmouse::msgs::RobotDescription mouse_;
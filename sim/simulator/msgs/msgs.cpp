@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include <sim/simulator/lib/common/json.hpp>
 #include "msgs.h"
 
@@ -12,14 +14,13 @@ smartmouse::msgs::Maze Convert(AbstractMaze *maze, std::string name, int size) {
   unsigned int r, c;
   for (r = 0; r < smartmouse::maze::SIZE; r++) {
     for (c = 0; c < smartmouse::maze::SIZE; c++) {
-      Node *n = maze->nodes[r][c];
-      if (n->neighbor(::Direction::E) == nullptr) {
+      if (maze->walls.is_wall(r, c, ::Direction::E)) {
         Wall *wall = maze_msg.add_walls();
         wall->set_row(r);
         wall->set_col(c);
         wall->set_direction(Direction_Dir_E);
       }
-      if (n->neighbor(::Direction::S) == nullptr) {
+      if (maze->walls.is_wall(r, c, ::Direction::S)) {
         Wall *wall = maze_msg.add_walls();
         wall->set_row(r);
         wall->set_col(c);
@@ -71,6 +72,16 @@ AbstractMaze Convert(smartmouse::msgs::Maze maze_msg) {
   return ::Direction::INVALID;
 }
 
+smartmouse::msgs::Direction::Dir Convert(::Direction dir) {
+  switch (dir) {
+    case ::Direction::N: return Direction_Dir_N;
+    case ::Direction::E: return Direction_Dir_E;
+    case ::Direction::S: return Direction_Dir_S;
+    case ::Direction::W:
+    default: return Direction_Dir_W;
+  }
+}
+
 RobotDescription Convert(std::ifstream &fs) {
   nlohmann::json json;
   json << fs;
@@ -173,6 +184,120 @@ void Convert(smartmouse::msgs::Maze maze, maze_walls_t &maze_lines) {
   }
 }
 
+void Convert(const MazeWalls &walls, const MazeWalls *previous, maze_walls_t &maze_lines) {
+  for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+    // each cell draws its own south and east walls, and the perimeter cells also draw the north and west sides
+    unsigned int changed = MazeWalls::FULL_ROW;
+    if (previous != nullptr) {
+      changed = (walls.horizontal[r] ^ previous->horizontal[r]) | (walls.vertical[r] ^ previous->vertical[r]);
+    }
+
+    for (; changed; changed &= changed - 1) {
+      const unsigned int c = __builtin_ctz(changed);
+      std::vector<smartmouse::msgs::WallPoints> &lines = maze_lines[r][c];
+      lines.clear();
+      for (auto dir : {::Direction::N, ::Direction::E, ::Direction::S, ::Direction::W}) {
+        const bool drawn = (dir == ::Direction::N && r == 0) || (dir == ::Direction::W && c == 0)
+                           || ((dir == ::Direction::E || dir == ::Direction::S) && walls.is_wall(r, c, dir));
+        if (!drawn) {
+          continue;
+        }
+        Wall wall;
+        wall.set_row(r);
+        wall.set_col(c);
+        wall.set_direction(Convert(dir));
+
+        double c1, r1, c2, r2;
+        std::tie(c1, r1, c2, r2) = WallToCoordinates(wall);
+        smartmouse::msgs::WallPoints wall_pts;
+        wall_pts.set_c1(c1);
+        wall_pts.set_r1(r1);
+        wall_pts.set_c2(c2);
+        wall_pts.set_r2(r2);
+        lines.push_back(wall_pts);
+      }
+    }
+  }
+}
+
+MazeDeltaEncoder::MazeDeltaEncoder(unsigned int keyframe_interval)
+    : keyframe_interval_(keyframe_interval), sequence_(0) {}
+
+MazeDelta MazeDeltaEncoder::Encode(const MazeWalls &walls, bool keyframe) {
+  MazeDelta msg;
+  msg.set_sequence(sequence_);
+  msg.set_size(smartmouse::maze::SIZE);
+  msg.set_keyframe(keyframe || sequence_ % keyframe_interval_ == 0);
+  sequence_++;
+
+  if (msg.keyframe()) {
+    msg.set_walls(reinterpret_cast<const char *>(&walls), sizeof(MazeWalls));
+  } else {
+    // every wall is the south or east wall of some cell, so that's all we need to send
+    for (unsigned int r = 0; r < smartmouse::maze::SIZE; r++) {
+      for (unsigned int changed = walls.horizontal[r] ^ last_.horizontal[r]; changed; changed &= changed - 1) {
+        const unsigned int c = __builtin_ctz(changed);
+        Wall *wall = walls.is_wall(r, c, ::Direction::S) ? msg.add_added() : msg.add_removed();
+        wall->set_row(r);
+        wall->set_col(c);
+        wall->set_direction(Direction_Dir_S);
+      }
+      for (unsigned int changed = walls.vertical[r] ^ last_.vertical[r]; changed; changed &= changed - 1) {
+        const unsigned int c = __builtin_ctz(changed);
+        Wall *wall = walls.is_wall(r, c, ::Direction::E) ? msg.add_added() : msg.add_removed();
+        wall->set_row(r);
+        wall->set_col(c);
+        wall->set_direction(Direction_Dir_E);
+      }
+    }
+  }
+
+  last_ = walls;
+  return msg;
+}
+
+MazeDeltaDecoder::MazeDeltaDecoder() : synced_(false), sequence_(0) {}
+
+bool MazeDeltaDecoder::Apply(const MazeDelta &msg) {
+  if (msg.size() != (int) smartmouse::maze::SIZE) {
+    return false;
+  }
+
+  if (msg.keyframe()) {
+    if (msg.walls().size() != sizeof(MazeWalls)) {
+      return false;
+    }
+    memcpy(&walls_, msg.walls().data(), sizeof(MazeWalls));
+  } else {
+    if (!synced_ || msg.sequence() != sequence_ + 1) {
+      synced_ = false;
+      return false;
+    }
+    for (const Wall &wall : msg.added()) {
+      if (wall.row() < smartmouse::maze::SIZE && wall.col() < smartmouse::maze::SIZE) {
+        walls_.add_wall(wall.row(), wall.col(), Convert(wall.direction()));
+      }
+    }
+    for (const Wall &wall : msg.removed()) {
+      if (wall.row() < smartmouse::maze::SIZE && wall.col() < smartmouse::maze::SIZE) {
+        walls_.remove_wall(wall.row(), wall.col(), Convert(wall.direction()));
+      }
+    }
+  }
+
+  synced_ = true;
+  sequence_ = msg.sequence();
+  return true;
+}
+
+bool MazeDeltaDecoder::Synced() const {
+  return synced_;
+}
+
+const MazeWalls &MazeDeltaDecoder::Walls() const {
+  return walls_;
+}
+
 std::tuple<double, double, double, double> WallToCoordinates(smartmouse::msgs::Wall wall) {
   double r = wall.row();
   double c = wall.col();
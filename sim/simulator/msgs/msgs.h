@@ -15,10 +15,52 @@ AbstractMaze Convert(smartmouse::msgs::Maze maze_msg);
 typedef std::vector<smartmouse::msgs::WallPoints> maze_walls_t[smartmouse::maze::SIZE][smartmouse::maze::SIZE];
 void Convert(smartmouse::msgs::Maze maze, maze_walls_t &maze_lines);
 
+/** \brief redraw the lines of the cells whose walls are different from previous, or every cell if it's null */
+void Convert(const MazeWalls &walls, const MazeWalls *previous, maze_walls_t &maze_lines);
+
+/** \brief turns a maze that changes a few walls at a time into MazeDelta messages with only the walls that changed.
+ * Every keyframe_interval messages all the walls are sent again, so anyone who missed a message can catch up.
+ */
+class MazeDeltaEncoder {
+ public:
+  explicit MazeDeltaEncoder(unsigned int keyframe_interval = 50);
+
+  /** \param keyframe send every wall even if it isn't time to, like when a whole new maze is loaded */
+  MazeDelta Encode(const MazeWalls &walls, bool keyframe = false);
+
+ private:
+  unsigned int keyframe_interval_;
+  uint64_t sequence_;
+  MazeWalls last_;
+};
+
+/** \brief keeps the walls up to date from a stream of MazeDelta messages */
+class MazeDeltaDecoder {
+ public:
+  MazeDeltaDecoder();
+
+  /** \return false if the message was ignored, because it was for another size of maze,
+   * or because it isn't a keyframe and a message was missed since the last keyframe
+   */
+  bool Apply(const MazeDelta &msg);
+
+  /** \return whether a keyframe has been applied, and no messages have been missed since */
+  bool Synced() const;
+
+  const MazeWalls &Walls() const;
+
+ private:
+  bool synced_;
+  uint64_t sequence_;
+  MazeWalls walls_;
+};
+
 ::Direction Convert(smartmouse::msgs::Direction dir_msg);
 
 ::Direction Convert(smartmouse::msgs::Direction::Dir dir_enum);
 
+smartmouse::msgs::Direction::Dir Convert(::Direction dir);
+
 RobotDescription Convert(std::ifstream &fs);
 
 double ConvertSec(ignition::msgs::Time time);
@@ -92,6 +92,29 @@ TEST(MsgsTest, MazeConversion) {
   EXPECT_EQ(maze, maze2);
 }
 
+TEST(MsgsTest, MazeDeltaCatchesUpAtKeyframes) {
+  smartmouse::msgs::MazeDeltaEncoder encoder(10);
+  smartmouse::msgs::MazeDeltaDecoder decoder;
+  MazeWalls walls;
+
+  srand(0);
+  for (int i = 0; i < 30; i++) {
+    walls.remove_wall(rand() % smartmouse::maze::SIZE, rand() % smartmouse::maze::SIZE,
+                      static_cast<::Direction>(rand() % 4));
+    smartmouse::msgs::MazeDelta msg = encoder.Encode(walls);
+    EXPECT_EQ(i % 10 == 0, msg.keyframe());
+
+    // drop message 12, so everything until the keyframe at 20 can't be applied
+    if (i == 12) {
+      continue;
+    }
+    EXPECT_EQ(i < 12 || i >= 20, decoder.Apply(msg)) << "message " << i;
+    if (decoder.Synced()) {
+      EXPECT_TRUE(walls == decoder.Walls());
+    }
+  }
+}
+
 TEST(MsgsTest, WallToCoordinates) {
   smartmouse::msgs::Wall wall;
   double c1, r1, c2, r2;